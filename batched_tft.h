@@ -0,0 +1,71 @@
+#ifndef BATCHED_TFT_H
+#define BATCHED_TFT_H
+
+#include "TFT_22_ILI9225.h"
+#include "lcdbus.h"
+
+// Display object that sends solid fills (rectangles, circles, straight
+// lines) through the batching display bus, and everything else (text,
+// outlines, clear) through the TFT library. Before handing the panel to
+// the library the bus ends its transaction and drops its register shadow.
+class BatchedTFT : public TFT_22_ILI9225 {
+ public:
+  BatchedTFT(int8_t rst, int8_t rs, int8_t cs, int8_t sdi, int8_t clk, int8_t led)
+    : TFT_22_ILI9225(rst, rs, cs, sdi, clk, led) {}
+  BatchedTFT(int8_t rst, int8_t rs, int8_t cs, int8_t led)
+    : TFT_22_ILI9225(rst, rs, cs, led) {}
+
+  void fillRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color) {
+    if (getOrientation() == 0) {
+      lcdFillRectangle(x1, y1, x2, y2, color);
+    } else {
+      lcdInvalidate();
+      TFT_22_ILI9225::fillRectangle(x1, y1, x2, y2, color);
+    }
+  }
+
+  void fillCircle(uint8_t x0, uint8_t y0, uint8_t radius, uint16_t color) {
+    if (getOrientation() == 0) {
+      lcdFillCircle(x0, y0, radius, color);
+    } else {
+      lcdInvalidate();
+      TFT_22_ILI9225::fillCircle(x0, y0, radius, color);
+    }
+  }
+
+  void drawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color) {
+    if (getOrientation() == 0 && (x1 == x2 || y1 == y2)) {
+      lcdFillRectangle(x1, y1, x2, y2, color);
+    } else {
+      lcdInvalidate();
+      TFT_22_ILI9225::drawLine(x1, y1, x2, y2, color);
+    }
+  }
+
+  void clear() {
+    lcdInvalidate();
+    TFT_22_ILI9225::clear();
+  }
+
+  void drawRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color) {
+    lcdInvalidate();
+    TFT_22_ILI9225::drawRectangle(x1, y1, x2, y2, color);
+  }
+
+  void drawCircle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t color) {
+    lcdInvalidate();
+    TFT_22_ILI9225::drawCircle(x0, y0, radius, color);
+  }
+
+  void drawPixel(uint16_t x1, uint16_t y1, uint16_t color) {
+    lcdInvalidate();
+    TFT_22_ILI9225::drawPixel(x1, y1, color);
+  }
+
+  uint16_t drawText(uint16_t x, uint16_t y, const char* s, uint16_t color = COLOR_WHITE) {
+    lcdInvalidate();
+    return TFT_22_ILI9225::drawText(x, y, s, color);
+  }
+};
+
+#endif
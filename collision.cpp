@@ -0,0 +1,31 @@
+#include "collision.h"
+
+bool sweptCircleHit(int startX, int startY, int endX, int endY, int targetX, int targetY, int hitRadius) {
+  long r2 = (long)hitRadius * hitRadius;
+  long dx = endX - startX;
+  long dy = endY - startY;
+  long fx = targetX - startX;
+  long fy = targetY - startY;
+  long len2 = dx * dx + dy * dy;
+  long t = fx * dx + fy * dy;  // Projection of the target onto the path, scaled by len2
+
+  // Closest point is the start of the path (or the circle didn't move)
+  if (len2 == 0 || t <= 0) {
+    return fx * fx + fy * fy < r2;
+  }
+
+  // Closest point is the end of the path
+  if (t >= len2) {
+    long ex = targetX - endX;
+    long ey = targetY - endY;
+    return ex * ex + ey * ey < r2;
+  }
+
+  // Closest point is inside the path: distance^2 * len2 == cross^2
+  long cross = dx * fy - dy * fx;
+  if (cross < 0) cross = -cross;
+  if (cross > 0xFFFF) {
+    return false;  // Far outside the hit radius, and cross^2 would overflow
+  }
+  return (unsigned long)cross * cross < (unsigned long)r2 * len2;
+}
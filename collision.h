@@ -0,0 +1,11 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include "Arduino.h"
+
+// Swept collision test: does a circle moving from (startX, startY) to
+// (endX, endY) pass closer than hitRadius to (targetX, targetY)? Integer
+// math only, so a fast ball can't skip over a target between two frames.
+bool sweptCircleHit(int startX, int startY, int endX, int endY, int targetX, int targetY, int hitRadius);
+
+#endif
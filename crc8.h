@@ -0,0 +1,10 @@
+#ifndef CRC8_H
+#define CRC8_H
+
+#include "Arduino.h"
+
+// CRC-8 (polynomial 0x07, initial value 0), shared by the leaderboard
+// records and the spectator frames. tools/spectator_decode.py has the same.
+uint8_t crc8(const uint8_t* data, uint8_t length);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#include "batched_tft.h"
+#include "trace.h"
+
+// The display object the game draws with: the batching display, wrapped
+// by the tracer when tracing is on
+#if TRACE_ENABLED
+typedef TracedTFT GameTFT;
+#else
+typedef BatchedTFT GameTFT;
+#endif
+
+#endif
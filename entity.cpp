@@ -0,0 +1,191 @@
+#include "entity.h"
+#include "collision.h"
+
+EntityStore entities;
+
+static const EntityDrawFn* drawTable = NULL;
+static uint16_t backgroundColor = 0;
+static uint8_t idsInUse[(ENTITY_CAPACITY + 7) / 8];
+
+// Empty the store without erasing anything (the screen is being replaced)
+void entityBegin(const EntityDrawFn* table, uint16_t background) {
+  drawTable = table;
+  backgroundColor = background;
+  entities.count = 0;
+  memset(idsInUse, 0, sizeof(idsInUse));
+}
+
+// Lowest id no live entity has. There is one, the store isn't full.
+static uint8_t takeId() {
+  uint8_t id = 0;
+  while (idsInUse[id / 8] & (1 << (id % 8))) {
+    id++;
+  }
+  idsInUse[id / 8] |= 1 << (id % 8);
+  return id;
+}
+
+static void drawEntity(uint8_t index, uint16_t color) {
+  if (drawTable != NULL) {
+    drawTable[entities.type[index]](entities.x[index], entities.y[index], entities.radius[index], color);
+  }
+}
+
+// Add and draw an entity. Returns its index, or -1 if the store is full.
+int entitySpawn(uint8_t type, uint8_t x, uint8_t y, uint8_t radius, uint16_t sprite,
+                uint16_t lifetimeMs, uint8_t action, int8_t amount) {
+  if (entities.count == ENTITY_CAPACITY) {
+    return -1;
+  }
+  uint8_t i = entities.count++;
+  entities.id[i] = takeId();
+  entities.type[i] = type;
+  entities.x[i] = x;
+  entities.y[i] = y;
+  entities.radius[i] = radius;
+  entities.sprite[i] = sprite;
+  entities.lifetime[i] = lifetimeMs;
+  entities.action[i] = action;
+  entities.amount[i] = amount;
+  drawEntity(i, sprite);
+  return i;
+}
+
+// Erase an entity and move the last one into its slot
+void entityRemove(uint8_t index) {
+  drawEntity(index, backgroundColor);
+  idsInUse[entities.id[index] / 8] &= ~(1 << (entities.id[index] % 8));
+  uint8_t last = --entities.count;
+  if (index != last) {
+    entities.id[index] = entities.id[last];
+    entities.type[index] = entities.type[last];
+    entities.x[index] = entities.x[last];
+    entities.y[index] = entities.y[last];
+    entities.radius[index] = entities.radius[last];
+    entities.sprite[index] = entities.sprite[last];
+    entities.lifetime[index] = entities.lifetime[last];
+    entities.action[index] = entities.action[last];
+    entities.amount[index] = entities.amount[last];
+  }
+}
+
+// Age every entity and remove the ones whose time is up
+void entityUpdate(uint16_t elapsedMs) {
+  uint8_t i = 0;
+  while (i < entities.count) {
+    if (entities.lifetime[i] <= elapsedMs) {
+      entityRemove(i);   // The last entity moved into i, look at it next
+    } else {
+      entities.lifetime[i] -= elapsedMs;
+      i++;
+    }
+  }
+}
+
+// Test every entity against the path of every ball. The first ball to
+// touch an entity gets it. Entities outside a ball's swept bounding box
+// are rejected with four compares.
+void entityCollide(const EntityBall* balls, uint8_t ballCount, EntityHitFn onHit) {
+  uint8_t i = 0;
+  while (i < entities.count) {
+    int ex = entities.x[i];
+    int ey = entities.y[i];
+    int er = entities.radius[i];
+    bool hit = false;
+
+    for (uint8_t b = 0; b < ballCount && !hit; b++) {
+      const EntityBall& ball = balls[b];
+      int reach = ball.radius + er;
+      if (ex + reach < min(ball.startX, ball.endX) || ex - reach > max(ball.startX, ball.endX) ||
+          ey + reach < min(ball.startY, ball.endY) || ey - reach > max(ball.startY, ball.endY)) {
+        continue;
+      }
+      if (sweptCircleHit(ball.startX, ball.startY, ball.endX, ball.endY, ex, ey, reach)) {
+        onHit(b, entities.type[i], entities.action[i], entities.amount[i]);
+        entityRemove(i);
+        hit = true;
+      }
+    }
+    if (!hit) {
+      i++;
+    }
+  }
+}
+
+#if ENTITY_BENCHMARK
+#define BENCHMARK_FRAMES 1000
+
+static void benchmarkHit(uint8_t, uint8_t, uint8_t, int8_t) {
+}
+
+// Draw functions that do nothing, so the dispatch is timed but not the
+// display
+static void benchmarkDraw(uint8_t, uint8_t, uint8_t, uint16_t) {
+}
+
+static const EntityDrawFn benchmarkDrawTable[ENTITY_TYPE_COUNT] = {
+  benchmarkDraw, benchmarkDraw, benchmarkDraw
+};
+
+// Top the store up to count mixed entities, so hit entities are replaced
+// and the count stays the same for the whole run
+static void benchmarkFill(uint8_t count) {
+  while (entities.count < count) {
+    uint8_t type = random(ENTITY_TYPE_COUNT);
+    entitySpawn(type, random(20, 160), random(50, 180), type == ENTITY_HAZARD ? 5 : 4,
+                0xFFFF, 60000U, ACTION_SCORE, 1);
+  }
+}
+
+// Time the update and collision passes, with the draw calls of the
+// entities they remove, for 3, 50 and 200 entities with two balls moving
+// like players do. Moving the balls and respawning happen between the
+// timed parts of each frame; the cost of reading the clock is taken off.
+void entityBenchmark() {
+  static const uint8_t counts[] = {3, 50, 200};
+  const EntityDrawFn* savedTable = drawTable;
+  uint16_t savedBackground = backgroundColor;
+
+  unsigned long clockCost = 0;
+  for (int frame = 0; frame < BENCHMARK_FRAMES; frame++) {
+    unsigned long start = micros();
+    clockCost += micros() - start;
+  }
+
+  for (uint8_t c = 0; c < sizeof(counts); c++) {
+    randomSeed(1);
+    entityBegin(benchmarkDrawTable, 0);
+    benchmarkFill(counts[c]);
+    EntityBall balls[2] = {{40, 190, 40, 190, 10}, {136, 190, 136, 190, 10}};
+    unsigned long elapsed = 0;
+    unsigned long removed = 0;
+    for (int frame = 0; frame < BENCHMARK_FRAMES; frame++) {
+      for (uint8_t b = 0; b < 2; b++) {
+        balls[b].startX = balls[b].endX;
+        balls[b].startY = balls[b].endY;
+        balls[b].endX = constrain(balls[b].endX + (int)random(-20, 21), 10, 166);
+        balls[b].endY = constrain(balls[b].endY + (int)random(-30, 31), 35, 190);
+      }
+      unsigned long start = micros();
+      entityUpdate(1);
+      entityCollide(balls, 2, benchmarkHit);
+      elapsed += micros() - start;
+      removed += counts[c] - entities.count;
+      benchmarkFill(counts[c]);
+    }
+    elapsed = elapsed > clockCost ? elapsed - clockCost : 0;
+
+    Serial.print(F("Entities "));
+    Serial.print(counts[c]);
+    Serial.print(F(": "));
+    Serial.print(elapsed / BENCHMARK_FRAMES);
+    Serial.print(F(" us/frame, "));
+    Serial.print(elapsed * (1000 / BENCHMARK_FRAMES) / counts[c]);
+    Serial.print(F(" ns/entity, "));
+    Serial.print(removed);
+    Serial.println(F(" removed"));
+  }
+
+  entityBegin(savedTable, savedBackground);
+}
+#endif
@@ -0,0 +1,76 @@
+#ifndef ENTITY_H
+#define ENTITY_H
+
+#include "Arduino.h"
+
+// Entity store for everything on the playfield that isn't a ball: coins,
+// power-ups and hazards. Components live in packed parallel arrays and
+// live entities always occupy [0, count), so the update and collision
+// passes are single loops over contiguous memory. Removing an entity moves
+// the last one into its place, so indexes change; an entity's id stays the
+// same while it lives (the lowest one free when it spawned). Each type has
+// a draw function in a table the game supplies.
+//
+// Build with ENTITY_BENCHMARK 1 to size the store for the frame cost
+// benchmark (too big for an Uno's RAM, run it on a Mega).
+#ifndef ENTITY_BENCHMARK
+#define ENTITY_BENCHMARK 0
+#endif
+
+#if ENTITY_BENCHMARK
+#define ENTITY_CAPACITY 200
+#else
+#define ENTITY_CAPACITY 8
+#endif
+
+enum EntityType {
+  ENTITY_COIN,
+  ENTITY_POWERUP,
+  ENTITY_HAZARD,
+  ENTITY_TYPE_COUNT
+};
+
+// What touching an entity does, with its amount
+enum EntityAction {
+  ACTION_SCORE,     // Add amount (may be negative) to the player's score
+  ACTION_COUNT
+};
+
+struct EntityStore {
+  uint8_t count;
+  uint8_t id[ENTITY_CAPACITY];
+  uint8_t type[ENTITY_CAPACITY];
+  uint8_t x[ENTITY_CAPACITY];
+  uint8_t y[ENTITY_CAPACITY];
+  uint8_t radius[ENTITY_CAPACITY];
+  uint16_t sprite[ENTITY_CAPACITY];     // Color the type's draw function uses
+  uint16_t lifetime[ENTITY_CAPACITY];   // ms left before the entity disappears
+  uint8_t action[ENTITY_CAPACITY];
+  int8_t amount[ENTITY_CAPACITY];
+};
+
+extern EntityStore entities;
+
+// Path a ball took this frame, for the collision pass
+struct EntityBall {
+  int startX, startY;
+  int endX, endY;
+  uint8_t radius;
+};
+
+// Draw an entity at (x, y) in color (its sprite, or the background to erase)
+typedef void (*EntityDrawFn)(uint8_t x, uint8_t y, uint8_t radius, uint16_t color);
+// A ball touched an entity
+typedef void (*EntityHitFn)(uint8_t ball, uint8_t type, uint8_t action, int8_t amount);
+
+void entityBegin(const EntityDrawFn* drawTable, uint16_t background);
+int entitySpawn(uint8_t type, uint8_t x, uint8_t y, uint8_t radius, uint16_t sprite,
+                uint16_t lifetimeMs, uint8_t action, int8_t amount);
+void entityRemove(uint8_t index);
+void entityUpdate(uint16_t elapsedMs);
+void entityCollide(const EntityBall* balls, uint8_t ballCount, EntityHitFn onHit);
+#if ENTITY_BENCHMARK
+void entityBenchmark();
+#endif
+
+#endif
@@ -1,6 +1,18 @@
 #include "SPI.h"
 #include "TFT_22_ILI9225.h"
 #include "math.h"
+#include "leaderboard.h"
+#include "timerwheel.h"
+#include "lcdbus.h"
+#include "batched_tft.h"
+#include "rle.h"
+#include "splash_shapes.h"
+#include "trace.h"
+#include "display.h"
+#include "idle.h"
+#include "spectator.h"
+#include "screen.h"
+#include "entity.h"
 
 // TFT Display Pins
 #define TFT_RST A4
@@ -12,6 +24,22 @@
 
 #define TFT_BRIGHTNESS 200 
 
+// Display transport. 0 bit-bangs SPI on the pins above. 1 uses the hardware
+// SPI port, which needs SDI on D11 and CLK on D13 and drives D10 (SS) as an
+// output, so no encoder or button may sit on those pins.
+#define LCD_HARDWARE_SPI 0
+
+// Text debug output over Serial, off when the link carries the trace or
+// spectator stream
+#if TRACE_ENABLED && SPECTATOR_ENABLED
+#error "The trace and spectator streams can't share the serial link"
+#endif
+#if TRACE_ENABLED || SPECTATOR_ENABLED
+#define SERIAL_DEBUG 0
+#else
+#define SERIAL_DEBUG 1
+#endif
+
 // Rotary Encoder 1 Inputs (Menu Navigation)
 #define inputCLK1 4
 #define inputDT1 5
@@ -22,6 +50,12 @@
 #define inputDT2 12
 #define buttonPin2 8  // Push button for encoder 2
 
+#define USES_PIN(pin) (inputCLK1 == (pin) || inputDT1 == (pin) || buttonPin1 == (pin) || \
+                       inputCLK2 == (pin) || inputDT2 == (pin) || buttonPin2 == (pin))
+#if LCD_HARDWARE_SPI && (USES_PIN(10) || USES_PIN(11) || USES_PIN(13))
+#error "LCD_HARDWARE_SPI needs D10, D11 and D13; move the encoders and buttons off them"
+#endif
+
 // Encoder variables
 int counter1 = 0; 
 int counter2 = 0; 
@@ -42,10 +76,20 @@ int encoderSpeed2 = 1;
 
 // Game constants
 #define GAME_TIME 60        // Game duration in seconds
-#define COIN_APPEAR_TIME 2500  // Coin appears every 1 second
-#define MAX_COINS 3         // Maximum number of coins on screen
+#define COIN_APPEAR_TIME 2500  // A pickup appears every 2.5 seconds
+#define MAX_PICKUPS 3       // Maximum number of coins, power-ups and hazards on screen
+#if MAX_PICKUPS > SPECTATOR_MAX_COINS
+#error "The spectator stream has room for SPECTATOR_MAX_COINS pickups"
+#endif
+#if MAX_PICKUPS > ENTITY_CAPACITY
+#error "MAX_PICKUPS doesn't fit in the entity store"
+#endif
+#define COIN_LIFETIME 6000  // Pickups disappear after 6 seconds if not collected
 #define BALL_RADIUS 10
 #define COIN_RADIUS 4
+#define HAZARD_SIZE 5       // Half the side of a hazard square
+#define POWERUP_POINTS 3
+#define HAZARD_POINTS -2
 #define BACKGROUND_COLOR COLOR_BLACK
 #define SCREEN_WIDTH 176
 #define SCREEN_HEIGHT 220
@@ -78,18 +122,6 @@ int prevX2, prevY2;           // Previous Ball 2 position
 int prevCounter1 = 0;
 int prevCounter2 = 0;
 
-// Coin variables
-struct Coin {
-  int x;
-  int y;
-  bool active;
-  unsigned long creationTime;
-};
-
-Coin coins[MAX_COINS];
-int coinIndex = 0;  // Index to track the next coin to create/replace
-unsigned long lastCoinTime = 0;
-
 // Score variables
 int score1 = 0;
 int score2 = 0;
@@ -102,12 +134,27 @@ int remainingTime = GAME_TIME;
 int prevRemainingTime = GAME_TIME;
 
 // Ground line redraw timer
-unsigned long lastGroundRedrawTime = 0;
 #define GROUND_REDRAW_INTERVAL 100  // Redraw ground line every 100ms
 
+// Boot timing, millis() at each step
+unsigned long bootStartTime = 0;       // Top of setup()
+unsigned long bootInputLiveTime = 0;   // First input edge would be acted on
+unsigned long bootMenuTime = 0;        // Start menu drawn
+#define SPLASH_SLICES 14    // Number of slices the welcome message is drawn in
+
+// Draw the splash graphic from the compressed asset instead of primitives
+#define SPLASH_FROM_ASSET 1
+// Draw the splash graphic both ways at boot and report each one's draw
+// time, next to the flash the asset takes
+#define SPLASH_COMPARE 0
+#define SPLASH_SHAPE_SLICES 6     // Slices covered by the splash_shapes asset
+#define SPLASH_BAND_LINES 22      // Asset lines decoded per slice
+unsigned long splashGraphicMicros = 0;
+
 // Function declarations
 void showResults();
 void redrawGroundLine();
+extern const EntityDrawFn entityDrawTable[ENTITY_TYPE_COUNT];
 
 // Function to reset all game variables
 void resetGame() {
@@ -127,12 +174,8 @@ void resetGame() {
   prevX2 = x2;
   prevY2 = y2;
 
-  // Reset coin states
-  for (int i = 0; i < MAX_COINS; i++) {
-    coins[i].active = false;
-  }
-  coinIndex = 0;
-  lastCoinTime = 0;
+  // Remove all pickups
+  entityBegin(entityDrawTable, BACKGROUND_COLOR);
 
   // Reset timers
   gameStartTime = millis();
@@ -157,31 +200,41 @@ void resetGame() {
 }
 
 void runGame();
-void createCoin();
+void spawnPickup();
 void updateScoreboard();
 void initializeGameScreen();
 void resetMenu();
 void updateMenu();
 void drawStartMenu();
-void drawShapes();
+bool drawShapes();
+void compareSplashPaths();
 void askPlayAgain();
+unsigned long idleTimeout();
 void updatePlayAgainMenu();
+void addMenuOptions();
+void showMessage(uint8_t screen, uint8_t x, const char* text, uint8_t* font);
 
 // Initialize TFT object
-TFT_22_ILI9225 tft = TFT_22_ILI9225(TFT_RST, TFT_RS, TFT_CS, TFT_SDI, TFT_CLK, TFT_LED);
+#if LCD_HARDWARE_SPI
+GameTFT tft = GameTFT(TFT_RST, TFT_RS, TFT_CS, TFT_LED);
+#else
+GameTFT tft = GameTFT(TFT_RST, TFT_RS, TFT_CS, TFT_SDI, TFT_CLK, TFT_LED);
+#endif
 
 void setup() {
+  bootStartTime = millis();
+
   // Initialize Serial Monitor
+#if TRACE_ENABLED
+  Serial.begin(TRACE_BAUD);
+  traceStart();
+#elif SPECTATOR_ENABLED
+  Serial.begin(SPECTATOR_BAUD);
+#else
   Serial.begin(9600);
   Serial.println("Initializing...");
+#endif
 
-  // Initialize TFT Display
-  tft.begin();
-  tft.setOrientation(1); // Landscape
-  tft.setBacklight(TFT_BRIGHTNESS);
-  tft.setBackgroundColor(BACKGROUND_COLOR);
-  tft.clear();
-  
   // Set encoder 1 pins
   pinMode(inputCLK1, INPUT);
   pinMode(inputDT1, INPUT);
@@ -198,23 +251,77 @@ void setup() {
   previousStateCLK2 = digitalRead(inputCLK2);
   previousStateDT2 = digitalRead(inputDT2);
 
+  // Wake from idle sleep on any encoder or button edge. Edges are latched
+  // from here on, so a tap while the display starts up skips the splash.
+  static const uint8_t inputPins[] = {inputCLK1, inputDT1, buttonPin1, inputCLK2, inputDT2, buttonPin2};
+  idleBegin(inputPins, sizeof(inputPins));
+
+  // Initialize TFT Display
+  tft.begin();
+  tft.setOrientation(1); // Landscape
+  tft.setBacklight(TFT_BRIGHTNESS);
+  tft.setBackgroundColor(BACKGROUND_COLOR);
+  tft.clear();
+#if LCD_HARDWARE_SPI
+  lcdBusBegin(&lcdHardwareSpiTransport, TFT_RS, TFT_CS, TFT_SDI, TFT_CLK);
+#else
+  lcdBusBegin(&lcdBitBangTransport, TFT_RS, TFT_CS, TFT_SDI, TFT_CLK);
+#endif
+
   // Initialize random seed
   randomSeed(analogRead(0));
 
-  // Initialize coins array
-  for (int i = 0; i < MAX_COINS; i++) {
-    coins[i].active = false;
-  }
+  // Start with no pickups
+  entityBegin(entityDrawTable, BACKGROUND_COLOR);
+#if ENTITY_BENCHMARK
+  entityBenchmark();
+#endif
 
+#if SERIAL_DEBUG
   Serial.println("Encoders and TFT Ready!");
-
-  // Draw initial visuals
+#endif
+
+  // Rebuild the high score index from the EEPROM log
+  leaderboardBegin();
+#if SERIAL_DEBUG
+  leaderboardPrintStats();
+#endif
+
+#if SPLASH_COMPARE && SERIAL_DEBUG
+  compareSplashPaths();
+#endif
+
+  // Draw initial visuals, any encoder or button edge skips the splash
+#if SERIAL_DEBUG
+  bool splashSkipped = drawShapes();
+#else
   drawShapes();
+#endif
   drawStartMenu();
+  bootMenuTime = millis();
+
+#if SERIAL_DEBUG
+  Serial.print(F("Splash graphic: "));
+  Serial.print(splashGraphicMicros);
+#if SPLASH_FROM_ASSET
+  Serial.println(F(" us from asset"));
+#else
+  Serial.println(F(" us from primitives"));
+#endif
+
+  Serial.print(F("Boot to first input: "));
+  Serial.print(bootInputLiveTime - bootStartTime);
+  Serial.print(F(" ms, to menu: "));
+  Serial.print(bootMenuTime - bootStartTime);
+  Serial.println(splashSkipped ? F(" ms (splash skipped)") : F(" ms"));
+#endif
 }
 
 void loop()
 {
+  // Keep streaming any trace events left over from the last game
+  TRACE_FLUSH();
+
   // Read the current state of inputCLKs
   currentStateCLK1 = digitalRead(inputCLK1);
   currentStateCLK2 = digitalRead(inputCLK2);
@@ -230,10 +337,12 @@ void loop()
       encdir1 = "CCW";
       menuIndex1 = (menuIndex1 - 1 + 2) % 2; // Toggle between 0 and 1
     }
+#if SERIAL_DEBUG
     Serial.print("Encoder 1 -> Direction: ");
     Serial.print(encdir1);
     Serial.print(" -- Value: ");
     Serial.println(counter1);
+#endif
     updateMenu(); // Update the menu display
   } 
   previousStateCLK1 = currentStateCLK1; 
@@ -249,10 +358,12 @@ void loop()
       encdir2 = "CCW";
       menuIndex2 = (menuIndex2 - 1 + 2) % 2; // Toggle between 0 and 1
     }
+#if SERIAL_DEBUG
     Serial.print("Encoder 2 -> Direction: ");
     Serial.print(encdir2);
     Serial.print(" -- Value: ");
     Serial.println(counter2);
+#endif
     updateMenu(); // Update the menu display
   } 
   previousStateCLK2 = currentStateCLK2;
@@ -261,7 +372,9 @@ void loop()
   boolean newButtonState1 = digitalRead(buttonPin1);
   if (newButtonState1 != buttonState1) {
     if (newButtonState1 == LOW) { 
+#if SERIAL_DEBUG
       Serial.println("Encoder 1 Button Pressed!");
+#endif
       locked1 = true; // Lock encoder 1
       if (menuIndex1 == 0) { // YES selected
         startGame1 = true;
@@ -276,7 +389,9 @@ void loop()
   boolean newButtonState2 = digitalRead(buttonPin2);
   if (newButtonState2 != buttonState2) {
     if (newButtonState2 == LOW) {
+#if SERIAL_DEBUG
       Serial.println("Encoder 2 Button Pressed!");
+#endif
       locked2 = true; // Lock encoder 2
       if (menuIndex2 == 0) { // YES selected
         startGame2 = true;
@@ -291,11 +406,10 @@ void loop()
   if (startGame1 && startGame2) {
     startGame1 = false; // Reset flag
     startGame2 = false;
-    tft.clear();
-    tft.drawText(26, 100, "Game Starts", COLOR_WHITE);
+    showMessage(SCREEN_GAME_STARTS, 26, "Game Starts", Terminal11x16);
     delay(500);
-    tft.clear();
     // Add game logic here
+    resetGame();
     initializeGameScreen();
     runGame();
     showResults();
@@ -305,10 +419,8 @@ void loop()
 
   // Display "Thank You" and reset the menu if both players selected "NO"
   if (locked1 && locked2 && menuIndex1 == 1 && menuIndex2 == 1) {
-    tft.clear();
-    tft.drawText(30, 100, "Thank You!", COLOR_WHITE);
-    delay(2000);
-    tft.clear();
+    showMessage(SCREEN_THANK_YOU, 30, "Thank You!", Terminal11x16);
+    idleDelay(2000);
     resetMenu(); // Reset the menu
   }
 
@@ -316,98 +428,246 @@ void loop()
   // Display "Thank You" and reset the menu if both players selected "NO"
   if (locked1 && locked2 && menuIndex1 == 1 && menuIndex2 == 1)
   {
-    tft.clear();
-    tft.drawText(30, 100, "Thank You!", COLOR_WHITE);
-    delay(2000);
-    tft.clear();
+    showMessage(SCREEN_THANK_YOU, 30, "Thank You!", Terminal11x16);
+    idleDelay(2000);
     resetMenu(); // Reset the menu
   }
+
+  // Nothing left to do until an input edge or the next timer deadline
+  idleWait(idleTimeout());
+}
+
+// How long the menu loop may sleep. While tracing, wake up regularly to
+// keep the trace stream flowing.
+unsigned long idleTimeout() {
+#if TRACE_ENABLED
+  return 10;
+#else
+  return timerWheelNextDeadline(millis());
+#endif
+}
+
+// Draw one slice of the welcome message, returns how long to hold it in ms
+unsigned long drawSplashSlice(int slice) {
+  switch (slice) {
+    case 0:
+      tft.setOrientation(4);
+      tft.drawRectangle(0, 0, 175, 219, COLOR_WHITE);
+      tft.drawRectangle(25, 45, 150, 175, COLOR_BLACK);
+      break;
+    case 1:
+      tft.drawRectangle(10, 10, 100, 60, COLOR_RED);
+      break;
+    case 2:
+      tft.fillRectangle(120, 10, 170, 60, COLOR_BLUE);
+      break;
+    case 3:
+      tft.drawCircle(55, 120, 30, COLOR_GREEN);
+      break;
+    case 4:
+      tft.fillCircle(140, 120, 30, COLOR_YELLOW);
+      break;
+    case 5:
+      tft.drawLine(10, 160, 170, 160, COLOR_YELLOW);
+      break;
+    case 6:
+      tft.setFont(Terminal12x16);
+      tft.drawText(10, 180, "Hello, PLAYERS", COLOR_WHITE);
+      return 300;
+    case 7:
+      tft.clear();
+      break;
+    case 8:
+      tft.drawRectangle(0, 0, 175, 219, COLOR_WHITE);
+      tft.drawRectangle(25, 45, 150, 175, COLOR_BLACK);
+      break;
+    case 9:
+      tft.setFont(Terminal11x16);
+      tft.drawText(37, 45, "Welcome to", COLOR_WHITE);
+      break;
+    case 10:
+      tft.setFont(Terminal12x16);
+      tft.drawText(20, 85, "HUNGRY BALLS", COLOR_DARKCYAN);
+      break;
+    case 11:
+      tft.setFont(Terminal11x16);
+      tft.drawText(22, 125, "Eat more coins", COLOR_YELLOW);
+      break;
+    case 12:
+      tft.drawText(50, 155, ".. WIN ..", COLOR_YELLOW);
+      break;
+    case 13:
+      tft.drawText(20, 190, "Time Limit: 60", COLOR_WHITE);
+      return 1500;
+  }
+  return 0;
+}
+
+// Check all encoder and button inputs for an edge during the splash,
+// including one latched by the pin change interrupt while the display was
+// starting up. The states are tracked so the skipping input doesn't leak
+// into the menu.
+bool splashInputEdge() {
+  // The first check is when an input can first take effect
+  if (bootInputLiveTime == 0) {
+    bootInputLiveTime = millis();
+  }
+  bool edge = idleTakeEdge();
+
+  currentStateCLK1 = digitalRead(inputCLK1);
+  currentStateDT1 = digitalRead(inputDT1);
+  currentStateCLK2 = digitalRead(inputCLK2);
+  currentStateDT2 = digitalRead(inputDT2);
+  boolean newButtonState1 = digitalRead(buttonPin1);
+  boolean newButtonState2 = digitalRead(buttonPin2);
+
+  if (currentStateCLK1 != previousStateCLK1 || currentStateDT1 != previousStateDT1 ||
+      currentStateCLK2 != previousStateCLK2 || currentStateDT2 != previousStateDT2 ||
+      newButtonState1 != buttonState1 || newButtonState2 != buttonState2) {
+    edge = true;
+  }
+
+  previousStateCLK1 = currentStateCLK1;
+  previousStateDT1 = currentStateDT1;
+  previousStateCLK2 = currentStateCLK2;
+  previousStateDT2 = currentStateDT2;
+  buttonState1 = newButtonState1;
+  buttonState2 = newButtonState2;
+
+  return edge;
 }
 
-// Welcome message
-void drawShapes() {
+// Stream the splash graphic from flash into one full-screen window, a band
+// of lines at a time with input polled in between. Returns true if skipped.
+bool drawSplashAsset() {
+  RleDecoder decoder;
+  rleBegin(&decoder, &splashShapes);
   tft.setOrientation(4);
-  tft.drawRectangle(0, 0, 175, 219, COLOR_WHITE);
-  tft.drawRectangle(25, 45, 150, 175, COLOR_BLACK);
-  tft.drawRectangle(10, 10, 100, 60, COLOR_RED);
-  tft.fillRectangle(120, 10, 170, 60, COLOR_BLUE);
-  tft.drawCircle(55, 120, 30, COLOR_GREEN);
-  tft.fillCircle(140, 120, 30, COLOR_YELLOW);
-  tft.drawLine(10, 160, 170, 160, COLOR_YELLOW);
-  tft.setFont(Terminal12x16);
-  tft.drawText(10, 180, "Hello, PLAYERS", COLOR_WHITE);
-  delay(300);
+
+  for (int line = 0; line < splashShapes.height; line += SPLASH_BAND_LINES) {
+    unsigned long startTime = micros();
+    if (line == 0) {
+      lcdSetWindow(0, 0, splashShapes.width - 1, splashShapes.height - 1);
+    } else {
+      lcdResume();
+    }
+    rleDecode(&decoder, splashShapes.width * SPLASH_BAND_LINES, lcdWriteRun);
+    lcdRelease();
+    splashGraphicMicros += micros() - startTime;
+
+    if (splashInputEdge()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+#if SPLASH_COMPARE && SERIAL_DEBUG
+// Time the splash graphic drawn from primitives and from the asset, one
+// after the other, and print both
+void compareSplashPaths() {
+  unsigned long startTime = micros();
+  for (int slice = 0; slice < SPLASH_SHAPE_SLICES; slice++) {
+    drawSplashSlice(slice);
+  }
+  unsigned long primitiveMicros = micros() - startTime;
+
   tft.clear();
-  tft.drawRectangle(0, 0, 175, 219, COLOR_WHITE);
-  tft.drawRectangle(25, 45, 150, 175, COLOR_BLACK);
-  tft.setFont(Terminal11x16);
-  tft.drawText(37, 45, "Welcome to", COLOR_WHITE);
-  tft.setFont(Terminal12x16);
-  tft.drawText(20, 85, "HUNGRY BALLS", COLOR_DARKCYAN);
-  tft.setFont(Terminal11x16);
-  tft.drawText(22, 125, "Eat more coins", COLOR_YELLOW);
-  tft.drawText(50, 155, ".. WIN ..", COLOR_YELLOW);
-  tft.drawText(20, 190, "Time Limit: 60", COLOR_WHITE);
-  delay(1500);
+  splashGraphicMicros = 0;
+  bool skipped = drawSplashAsset();
   tft.clear();
+
+  Serial.print(F("Splash graphic: primitives "));
+  Serial.print(primitiveMicros);
+  Serial.print(F(" us, asset "));
+  Serial.print(splashGraphicMicros);
+  Serial.print(skipped ? F(" us (cut short)") : F(" us"));
+  Serial.print(F(", asset flash "));
+  Serial.print(sizeof(splashShapes_data) + sizeof(splashShapes_palette));
+  Serial.println(F(" bytes"));
 }
+#endif
 
-// Function to draw the Start Menu
-void drawStartMenu() {
-  tft.setOrientation(4);
-  tft.setFont(Terminal12x16);
-  tft.drawText(5, 10, "Do you want to", COLOR_WHITE);
-  tft.drawText(5, 35, "START the Game?", COLOR_WHITE);
-  // Draw "YES" and "NO" options
-  tft.drawText(10, 80, " YES", COLOR_WHITE);
-  tft.drawText(10, 120, " NO", COLOR_WHITE);
-  tft.setFont(Terminal11x16);
-  tft.drawText(10, 164, "Player1 -> RED", COLOR_RED);
-  tft.drawText(10, 190, "Player2 -> BLUE", COLOR_BLUE);
+// Welcome message, drawn slice by slice with input polled in between.
+// Returns true if a player skipped it.
+bool drawShapes() {
+  int firstSlice = 0;
+  splashGraphicMicros = 0;
 
-  // Highlight the selected option for PLAYER 1
-  if (menuIndex1 == 0) {
-    tft.drawRectangle(5, 76, 170, 97, COLOR_RED);
-  } else if (menuIndex1 == 1) {
-    tft.drawRectangle(5, 116, 170, 137, COLOR_RED);
+#if SPLASH_FROM_ASSET
+  if (drawSplashAsset()) {
+    tft.clear();
+    return true;
   }
+  firstSlice = SPLASH_SHAPE_SLICES;
+#endif
+
+  for (int slice = firstSlice; slice < SPLASH_SLICES; slice++) {
+    unsigned long startTime = micros();
+    unsigned long holdTime = drawSplashSlice(slice);
+    unsigned long sliceDoneTime = millis();
+    if (slice < SPLASH_SHAPE_SLICES) {
+      splashGraphicMicros += micros() - startTime;
+    }
 
-  // Highlight the selected option for PLAYER 2
-  if (menuIndex2 == 0) {
-    tft.drawRectangle(2, 73, 173, 100, COLOR_BLUE);
-  } else if (menuIndex2 == 1) {
-    tft.drawRectangle(2, 113.5, 173, 140, COLOR_BLUE); 
+    do {
+      if (splashInputEdge()) {
+        tft.clear();
+        return true;
+      }
+    } while (millis() - sliceDoneTime < holdTime);
   }
+  tft.clear();
+  return false;
+}
+
+// Function to draw the Start Menu
+void drawStartMenu() {
+  tft.setOrientation(4);
   updateMenu();
 }
 
-// Function to update the menu (without clearing the entire screen)
+// Function to update the menu. Only what changed since the screen on the
+// panel is redrawn.
 void updateMenu() {
-  // Erase the previous rectangles by drawing black rectangles
-  tft.fillRectangle(5, 76, 170, 97, COLOR_BLACK); // Erase Player 1's previous rectangle
-  tft.fillRectangle(5, 116, 170, 137, COLOR_BLACK); // Erase Player 1's previous rectangle
-  tft.fillRectangle(2, 73, 173, 100, COLOR_BLACK); // Erase Player 2's previous rectangle
-  tft.fillRectangle(2, 113.5, 173, 140, COLOR_BLACK); // Erase Player 2's previous rectangle
+  screenBegin(SCREEN_MENU);
+  screenText(5, 10, "Do you want to", COLOR_WHITE, Terminal12x16);
+  screenText(5, 35, "START the Game?", COLOR_WHITE, Terminal12x16);
+  addMenuOptions();
+  screenText(10, 164, "Player1 -> RED", COLOR_RED, Terminal11x16);
+  screenText(10, 190, "Player2 -> BLUE", COLOR_BLUE, Terminal11x16);
+  screenEnd(tft);
+  idleMarkRedrawn();
+}
 
-  // Redraw the text (to ensure it's not overwritten by the black rectangles)
-  tft.drawText(10, 80, " YES", COLOR_WHITE);
-  tft.drawText(10, 120, " NO", COLOR_WHITE); 
+// "YES" and "NO" options with each player's selection, shared by the start
+// and play again menus
+void addMenuOptions() {
+  screenText(10, 80, " YES", COLOR_WHITE, Terminal12x16);
+  screenText(10, 120, " NO", COLOR_WHITE, Terminal12x16);
 
   // Highlight the selected option for PLAYER 1
   if (menuIndex1 == 0) {
-    tft.drawRectangle(5, 76, 170, 97, COLOR_RED); 
+    screenRectangle(5, 76, 170, 97, COLOR_RED);
   } else if (menuIndex1 == 1) {
-    tft.drawRectangle(5, 116, 170, 137, COLOR_RED);
+    screenRectangle(5, 116, 170, 137, COLOR_RED);
   }
 
   // Highlight the selected option for PLAYER 2
   if (menuIndex2 == 0) {
-    tft.drawRectangle(2, 73, 173, 100, COLOR_BLUE); 
+    screenRectangle(2, 73, 173, 100, COLOR_BLUE);
   } else if (menuIndex2 == 1) {
-    tft.drawRectangle(2, 113.5, 173, 140, COLOR_BLUE);
+    screenRectangle(2, 113, 173, 140, COLOR_BLUE);
   }
 }
 
+// Show a screen with a single line of text
+void showMessage(uint8_t screen, uint8_t x, const char* text, uint8_t* font) {
+  screenBegin(screen);
+  screenText(x, 100, text, COLOR_WHITE, font);
+  screenEnd(tft);
+}
+
 // Function to reset the menu
 void resetMenu() {
   locked1 = false; // Unlock encoder 1
@@ -420,17 +680,25 @@ void resetMenu() {
 // Initialize the game screen with static elements
 void initializeGameScreen() 
 {
-  // Draw the scoreboard background and static elements
-  tft.setFont(Terminal6x8);
-  tft.drawText(10, 5, "P1:", COLOR_RED);
-  tft.drawText(64, 5, "TIME:", COLOR_WHITE);
-  tft.drawText(136, 5, "P2:", COLOR_BLUE);
+  screenBegin(SCREEN_GAME);
+
+  // Scoreboard labels
+  screenText(10, 5, "P1:", COLOR_RED, Terminal6x8);
+  screenText(64, 5, "TIME:", COLOR_WHITE, Terminal6x8);
+  screenText(136, 5, "P2:", COLOR_BLUE, Terminal6x8);
   
-  // Draw separator line
-  tft.drawLine(0, 20, 220, 20, COLOR_WHITE);
+  // Separator line
+  screenLine(0, 20, SCREEN_WIDTH, 20, COLOR_WHITE);
   
-  // Draw ground line
-  tft.drawLine(0, GROUND_LEVEL, SCREEN_WIDTH, GROUND_LEVEL, COLOR_WHITE);
+  // Ground line
+  screenLine(0, GROUND_LEVEL, SCREEN_WIDTH, GROUND_LEVEL, COLOR_WHITE);
+
+  // Drawn by the game itself: scores, time, balls and coins
+  screenArea(30, 5, 50, 15);
+  screenArea(103, 5, 130, 15);
+  screenArea(156, 5, 175, 15);
+  screenArea(0, 21, SCREEN_WIDTH - 1, GROUND_LEVEL - 1);
+  screenEnd(tft);
 
   updateScoreboard();
 }
@@ -479,25 +747,94 @@ void updateScoreboard() {
   }
 }
 
-// Create a new coin
-void createCoin() {
-  // Erase the old coin at this index if it was active
-  if (coins[coinIndex].active) {
-    tft.fillCircle(coins[coinIndex].x, coins[coinIndex].y, COIN_RADIUS, BACKGROUND_COLOR);
+// How each pickup type looks
+void drawCoin(uint8_t x, uint8_t y, uint8_t radius, uint16_t color) {
+  tft.fillCircle(x, y, radius, color);
+}
+
+void drawPowerUp(uint8_t x, uint8_t y, uint8_t radius, uint16_t color) {
+  tft.fillCircle(x, y, radius, color);
+}
+
+void drawHazard(uint8_t x, uint8_t y, uint8_t radius, uint16_t color) {
+  tft.fillRectangle(x - radius, y - radius, x + radius, y + radius, color);
+}
+
+const EntityDrawFn entityDrawTable[ENTITY_TYPE_COUNT] = {drawCoin, drawPowerUp, drawHazard};
+
+// Spawn a coin, or now and then a power-up or a hazard. When the screen
+// already holds MAX_PICKUPS, the oldest one makes room.
+void spawnPickup() {
+  if (entities.count >= MAX_PICKUPS) {
+    uint8_t oldest = 0;
+    for (uint8_t i = 1; i < entities.count; i++) {
+      if (entities.lifetime[i] < entities.lifetime[oldest]) {
+        oldest = i;
+      }
+    }
+    entityRemove(oldest);
   }
-  
-  // Create a new coin
-  coins[coinIndex].x = random(20, 160);
-  coins[coinIndex].y = random(50, 180);
-  coins[coinIndex].active = true;
-  coins[coinIndex].creationTime = millis();
-  
-  // Draw the new coin
-  tft.fillCircle(coins[coinIndex].x, coins[coinIndex].y, COIN_RADIUS, COLOR_YELLOW);
-  
-  // Move to the next coin slot (circular buffer)
-  coinIndex = (coinIndex + 1) % MAX_COINS;
+
+  uint8_t x = random(20, 160);
+  uint8_t y = random(50, 180);
+  long kind = random(10);
+  if (kind == 0) {
+    entitySpawn(ENTITY_HAZARD, x, y, HAZARD_SIZE, COLOR_MAGENTA, COIN_LIFETIME, ACTION_SCORE, HAZARD_POINTS);
+  } else if (kind == 1) {
+    entitySpawn(ENTITY_POWERUP, x, y, COIN_RADIUS, COLOR_GREEN, COIN_LIFETIME, ACTION_SCORE, POWERUP_POINTS);
+  } else {
+    entitySpawn(ENTITY_COIN, x, y, COIN_RADIUS, COLOR_YELLOW, COIN_LIFETIME, ACTION_SCORE, 1);
+  }
+}
+
+// A ball ran into a pickup
+void onPickupHit(uint8_t ball, uint8_t, uint8_t action, int8_t amount) {
+  int* score = (ball == 0) ? &score1 : &score2;
+  if (action == ACTION_SCORE) {
+    *score = max(*score + amount, 0);
+  }
+}
+
+// Timer callback: spawn the next pickup
+void onPickupTimer(uint8_t) {
+  spawnPickup();
+}
+
+// Timer callback: one second of game time has passed
+void onCountdownTimer(uint8_t) {
+  remainingTime--;
+}
+
+// Timer callback: periodically redraw the ground line so it doesn't get erased
+void onGroundRedrawTimer(uint8_t) {
+  redrawGroundLine();
+}
+
+#if SPECTATOR_ENABLED
+// Timer callback: send the match state to the spectator stream
+void onSpectatorTimer(uint8_t) {
+  SpectatorSnapshot snapshot;
+  memset(&snapshot, 0, sizeof(snapshot));
+  snapshot.ballX[0] = constrain(x1, 0, 255);
+  snapshot.ballY[0] = constrain(y1, 0, 255);
+  snapshot.ballX[1] = constrain(x2, 0, 255);
+  snapshot.ballY[1] = constrain(y2, 0, 255);
+  snapshot.score[0] = score1;
+  snapshot.score[1] = score2;
+  snapshot.remainingTime = max(remainingTime, 0);
+  // A pickup keeps its slot while it lives: slots are entity ids, which
+  // stay below MAX_PICKUPS
+  for (uint8_t i = 0; i < entities.count; i++) {
+    uint8_t slot = entities.id[i];
+    if (slot < SPECTATOR_MAX_COINS) {
+      snapshot.coinActive |= 1 << slot;
+      snapshot.coinX[slot] = entities.x[i];
+      snapshot.coinY[slot] = entities.y[i];
+    }
+  }
+  spectatorSend(snapshot);
 }
+#endif
 
 // Calculate encoder speed multiplier based on time between rotations
 int calculateSpeedMultiplier(unsigned long lastTime) {
@@ -527,6 +864,7 @@ void redrawGroundLine() {
 // Main game loop
 void runGame() {
   unsigned long currentTime;
+  unsigned long lastFrameTime;
   
   // Initialize previous positions
   prevX1 = x1;
@@ -537,15 +875,35 @@ void runGame() {
   // Draw initial ball positions
   tft.fillCircle(x1, y1, BALL_RADIUS, COLOR_RED);
   tft.fillCircle(x2, y2, BALL_RADIUS, COLOR_BLUE);
+
+  // Schedule the timed game events
+  gameStartTime = millis();
+  timerWheelReset(gameStartTime);
+  lastFrameTime = gameStartTime;
+  timerStart(1000, 1000, onCountdownTimer, 0);
+  timerStart(0, COIN_APPEAR_TIME, onPickupTimer, 0);
+  timerStart(GROUND_REDRAW_INTERVAL, GROUND_REDRAW_INTERVAL, onGroundRedrawTimer, 0);
+#if SPECTATOR_ENABLED
+  spectatorBegin();
+  timerStart(0, SPECTATOR_TICK_MS, onSpectatorTimer, 0);
+#endif
   
   // Game loop runs until time is up
   while (remainingTime > 0) {
+    TRACE_BEGIN(TRACE_FRAME);
+    lcdBeginFrame();  // Keep the display selected for the whole iteration
     currentTime = millis();
     
-    // Update remaining time
-    remainingTime = GAME_TIME - ((currentTime - gameStartTime) / 1000);
+    // Fire any timers that are due (countdown, pickup spawn, ground redraw)
+    // and age the pickups
+    TRACE_BEGIN(TRACE_TIMERS);
+    timerWheelAdvance(currentTime);
+    entityUpdate(currentTime - lastFrameTime);
+    lastFrameTime = currentTime;
+    TRACE_END(TRACE_TIMERS);
     
     // Read encoder states for movement
+    TRACE_BEGIN(TRACE_INPUT);
     currentStateCLK1 = digitalRead(inputCLK1);
     currentStateDT1 = digitalRead(inputDT1);
     currentStateCLK2 = digitalRead(inputCLK2);
@@ -602,14 +960,10 @@ void runGame() {
     // Check button states for jumping
     buttonState1 = digitalRead(buttonPin1);
     buttonState2 = digitalRead(buttonPin2);
-    
-    // Create a new coin every second
-    if (currentTime - lastCoinTime > COIN_APPEAR_TIME) {
-      createCoin();
-      lastCoinTime = currentTime;
-    }
+    TRACE_END(TRACE_INPUT);
     
     // Update ball positions based on encoder movement
+    TRACE_BEGIN(TRACE_MOVE);
     if (counter1 != prevCounter1) {
       // Move ball 1 based on encoder direction and speed
       int moveX = (counter1 - prevCounter1) * BASE_MOVEMENT_SPEED * encoderSpeed1;
@@ -632,10 +986,12 @@ void runGame() {
       prevCounter1 = counter1;
       
       // Debug output
+#if SERIAL_DEBUG
       Serial.print("P1 Move: ");
       Serial.print(moveX);
       Serial.print(" Speed Multiplier: ");
       Serial.println(encoderSpeed1);
+#endif
     }
     
     if (counter2 != prevCounter2) {
@@ -660,10 +1016,12 @@ void runGame() {
       prevCounter2 = counter2;
       
       // Debug output
+#if SERIAL_DEBUG
       Serial.print("P2 Move: ");
       Serial.print(moveX);
       Serial.print(" Speed Multiplier: ");
       Serial.println(encoderSpeed2);
+#endif
     }
     
     // Update vertical position based on button state (jumping)
@@ -706,35 +1064,26 @@ void runGame() {
       }
     }
     
-    // Check for coin collection
-    for (int i = 0; i < MAX_COINS; i++) {
-      if (coins[i].active) {
-        // Check if ball 1 collected the coin
-        if (sqrt(pow(x1 - coins[i].x, 2) + pow(y1 - coins[i].y, 2)) < (BALL_RADIUS + COIN_RADIUS)) {
-          score1++;
-          coins[i].active = false;
-          tft.fillCircle(coins[i].x, coins[i].y, COIN_RADIUS, BACKGROUND_COLOR);
-        }
-        
-        // Check if ball 2 collected the coin
-        if (sqrt(pow(x2 - coins[i].x, 2) + pow(y2 - coins[i].y, 2)) < (BALL_RADIUS + COIN_RADIUS)) {
-          score2++;
-          coins[i].active = false;
-          tft.fillCircle(coins[i].x, coins[i].y, COIN_RADIUS, BACKGROUND_COLOR);
-        }
-      }
-    }
+    TRACE_END(TRACE_MOVE);
+
+    // Check for pickups along the path each ball took this frame, so a
+    // fast ball can't skip over one between two iterations
+    TRACE_BEGIN(TRACE_COLLIDE);
+    EntityBall balls[2] = {
+      {prevX1, prevY1, x1, y1, BALL_RADIUS},
+      {prevX2, prevY2, x2, y2, BALL_RADIUS}
+    };
+    entityCollide(balls, 2, onPickupHit);
+    
+    TRACE_END(TRACE_COLLIDE);
     
     // Update the scoreboard if needed
+    TRACE_BEGIN(TRACE_SCOREBOARD);
     updateScoreboard();
-    
-    // Periodically redraw the ground line to ensure it doesn't get erased
-    if (currentTime - lastGroundRedrawTime > GROUND_REDRAW_INTERVAL) {
-      redrawGroundLine();
-      lastGroundRedrawTime = currentTime;
-    }
+    TRACE_END(TRACE_SCOREBOARD);
     
     // Only redraw balls if they've moved
+    TRACE_BEGIN(TRACE_DRAW_BALLS);
     if (x1 != prevX1 || y1 != prevY1) {
       // Erase previous ball position
       tft.fillCircle(prevX1, prevY1, BALL_RADIUS, BACKGROUND_COLOR);
@@ -769,37 +1118,63 @@ void runGame() {
       }
     }
     
+    TRACE_END(TRACE_DRAW_BALLS);
+    lcdEndFrame();
+    TRACE_END(TRACE_FRAME);
+    TRACE_FLUSH();
+    
     // Small delay to control game speed
     delay(0.5); // Minimal delay for maximum game speed
   }
+
+  // Drop any timers still pending (pickup spawn etc.)
+  timerWheelReset(millis());
+#if SPECTATOR_ENABLED
+  onSpectatorTimer(0);   // Final state, then the end marker
+  spectatorEnd();
+#endif
 }
 
 // Modify the showResults() function to add a restart option
 void showResults() {
-  tft.clear();
-  tft.setFont(Terminal12x16);
-  
-  tft.drawText(40, 40, "GAME OVER", COLOR_WHITE);
+  // Store the match first so the best score includes it
+  leaderboardRecordMatch(score1, score2, GAME_TIME);
+
+  screenBegin(SCREEN_RESULTS);
+  screenText(40, 40, "GAME OVER", COLOR_WHITE, Terminal12x16);
   
   // Display scores
   char score1Str[20];
   sprintf(score1Str, "P1: %d", score1);
-  tft.drawText(40, 80, score1Str, COLOR_RED);
+  screenText(40, 80, score1Str, COLOR_RED, Terminal12x16);
   
   char score2Str[20];
   sprintf(score2Str, "P2: %d", score2);
-  tft.drawText(40, 110, score2Str, COLOR_BLUE);
+  screenText(40, 110, score2Str, COLOR_BLUE, Terminal12x16);
   
   // Display winner
   if (score1 > score2) {
-    tft.drawText(40, 150, "P1 WINS!", COLOR_RED);
+    screenText(40, 150, "P1 WINS!", COLOR_RED, Terminal12x16);
   } else if (score2 > score1) {
-    tft.drawText(40, 150, "P2 WINS!", COLOR_BLUE);
+    screenText(40, 150, "P2 WINS!", COLOR_BLUE, Terminal12x16);
   } else {
-    tft.drawText(40, 150, "IT'S A TIE!", COLOR_WHITE);
+    screenText(40, 150, "IT'S A TIE!", COLOR_WHITE, Terminal12x16);
   }
+
+  // Show the best score so far
+  char bestStr[20];
+  sprintf(bestStr, "BEST: %d", leaderboardBestScore());
+  screenText(40, 185, bestStr, COLOR_YELLOW, Terminal12x16);
+  screenEnd(tft);
+
+#if SERIAL_DEBUG
+  leaderboardPrintStats();
+  lcdPrintStats();
+  idlePrintStats();
+  screenPrintStats();
+#endif
   
-  delay(3000); // Show results for 3 seconds
+  idleDelay(3000); // Show results for 3 seconds
   
   // Ask if players want to play again
   askPlayAgain();
@@ -807,8 +1182,6 @@ void showResults() {
 
 // Add a new function to ask players if they want to play again
 void askPlayAgain() {
-  tft.clear();
-  
   // Reset encoder states for new input
   locked1 = false;
   locked2 = false;
@@ -817,26 +1190,7 @@ void askPlayAgain() {
   startGame1 = false;
   startGame2 = false;
   
-  tft.setFont(Terminal12x16);
-  tft.drawText(5, 10, "Play Again?", COLOR_WHITE);
-  
-  // Draw "YES" and "NO" options
-  tft.drawText(10, 80, " YES", COLOR_WHITE);
-  tft.drawText(10, 120, " NO", COLOR_WHITE);
-  
-  // Highlight the selected option for PLAYER 1
-  if (menuIndex1 == 0) {
-    tft.drawRectangle(5, 76, 170, 97, COLOR_RED);
-  } else if (menuIndex1 == 1) {
-    tft.drawRectangle(5, 116, 170, 137, COLOR_RED);
-  }
-
-  // Highlight the selected option for PLAYER 2
-  if (menuIndex2 == 0) {
-    tft.drawRectangle(2, 73, 173, 100, COLOR_BLUE);
-  } else if (menuIndex2 == 1) {
-    tft.drawRectangle(2, 113.5, 173, 140, COLOR_BLUE); 
-  }
+  updatePlayAgainMenu();
   
   // Wait for player inputs
   boolean playAgainDecided = false;
@@ -897,16 +1251,13 @@ void askPlayAgain() {
     // Start a new game if both players selected "YES"
     if (startGame1 && startGame2) {
       playAgainDecided = true;
-      tft.clear();
-      tft.drawText(26, 100, "Game Starts", COLOR_WHITE);
+      showMessage(SCREEN_GAME_STARTS, 26, "Game Starts", Terminal12x16);
       delay(500);
-      tft.clear();
       
       // Reset game variables
       resetGame();
       
       // Initialize game screen and start a new game
-      gameStartTime = millis();
       initializeGameScreen();
       runGame();
       showResults(); // This will recursively call askPlayAgain after the game
@@ -916,38 +1267,20 @@ void askPlayAgain() {
     // Return to main menu if either player selected "NO"
     if ((locked1 && menuIndex1 == 1) || (locked2 && menuIndex2 == 1)) {
       playAgainDecided = true;
-      tft.clear();
       resetMenu(); // Reset the menu and return to main menu
       return;
     }
     
-    delay(10); // Small delay to prevent CPU hogging
+    TRACE_FLUSH();
+    idleWait(idleTimeout()); // Sleep until the next input edge
   }
 }
 
 // Add a function to update the play again menu
 void updatePlayAgainMenu() {
-  // Erase the previous rectangles by drawing black rectangles
-  tft.fillRectangle(5, 76, 170, 97, COLOR_BLACK); // Erase Player 1's previous rectangle
-  tft.fillRectangle(5, 116, 170, 137, COLOR_BLACK); // Erase Player 1's previous rectangle
-  tft.fillRectangle(2, 73, 173, 100, COLOR_BLACK); // Erase Player 2's previous rectangle
-  tft.fillRectangle(2, 113.5, 173, 140, COLOR_BLACK); // Erase Player 2's previous rectangle
-
-  // Redraw the text
-  tft.drawText(10, 80, " YES", COLOR_WHITE);
-  tft.drawText(10, 120, " NO", COLOR_WHITE); 
-
-  // Highlight the selected option for PLAYER 1
-  if (menuIndex1 == 0) {
-    tft.drawRectangle(5, 76, 170, 97, COLOR_RED); 
-  } else if (menuIndex1 == 1) {
-    tft.drawRectangle(5, 116, 170, 137, COLOR_RED);
-  }
-
-  // Highlight the selected option for PLAYER 2
-  if (menuIndex2 == 0) {
-    tft.drawRectangle(2, 73, 173, 100, COLOR_BLUE); 
-  } else if (menuIndex2 == 1) {
-    tft.drawRectangle(2, 113.5, 173, 140, COLOR_BLUE);
-  }
+  screenBegin(SCREEN_PLAY_AGAIN);
+  screenText(5, 10, "Play Again?", COLOR_WHITE, Terminal12x16);
+  addMenuOptions();
+  screenEnd(tft);
+  idleMarkRedrawn();
 }
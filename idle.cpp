@@ -0,0 +1,225 @@
+#include "idle.h"
+
+#ifndef HOST_BUILD
+#include <avr/sleep.h>
+#include <avr/interrupt.h>
+#endif
+
+IdleStats idleStats;
+
+static volatile bool inputEdgePending = false;
+static volatile bool latencyPending = false;
+static volatile unsigned long inputEdgeTime = 0;   // micros() of the first unhandled edge
+static unsigned long accountingStart = 0;          // millis() of the last report
+static unsigned long idleMicrosCarry = 0;          // Idle time not yet added to idleMillis
+
+// Input pins without a pin change interrupt, and their last level
+static uint8_t polledPins[IDLE_MAX_POLLED_PINS];
+static uint8_t polledLevels[IDLE_MAX_POLLED_PINS];
+static uint8_t polledCount = 0;
+
+// Any pin change on an input pin: remember it and when it happened
+static void onInputEdge() {
+  inputEdgePending = true;
+  if (!latencyPending) {
+    latencyPending = true;
+    inputEdgeTime = micros();
+  }
+}
+
+#ifdef HOST_BUILD
+// Host builds have no pin change interrupts; the harness calls this when
+// it changes an input
+void idleInjectEdge() {
+  onInputEdge();
+}
+#else
+ISR(PCINT0_vect) {
+  onInputEdge();
+}
+
+ISR(PCINT1_vect) {
+  onInputEdge();
+}
+
+ISR(PCINT2_vect) {
+  onInputEdge();
+}
+#endif
+
+// Enable pin change interrupts on the given input pins. Pins that have
+// none are polled whenever the Timer0 tick wakes the CPU.
+void idleBegin(const uint8_t* pins, uint8_t pinCount) {
+  polledCount = 0;
+  for (uint8_t i = 0; i < pinCount; i++) {
+#ifndef HOST_BUILD
+    volatile uint8_t* pcicr = digitalPinToPCICR(pins[i]);
+    volatile uint8_t* pcmsk = digitalPinToPCMSK(pins[i]);
+    if (pcicr != NULL && pcmsk != NULL) {
+      *pcmsk |= bit(digitalPinToPCMSKbit(pins[i]));
+      *pcicr |= bit(digitalPinToPCICRbit(pins[i]));
+      continue;
+    }
+#endif
+    if (polledCount < IDLE_MAX_POLLED_PINS) {
+      polledPins[polledCount] = pins[i];
+      polledLevels[polledCount] = digitalRead(pins[i]);
+      polledCount++;
+    }
+  }
+#ifndef HOST_BUILD
+  set_sleep_mode(SLEEP_MODE_IDLE);
+#endif
+  memset(&idleStats, 0, sizeof(idleStats));
+  idleMicrosCarry = 0;
+  accountingStart = millis();
+}
+
+// Look for edges on the pins without a pin change interrupt
+static void pollInputs() {
+  for (uint8_t i = 0; i < polledCount; i++) {
+    uint8_t level = digitalRead(polledPins[i]);
+    if (level != polledLevels[i]) {
+      polledLevels[i] = level;
+      onInputEdge();
+    }
+  }
+}
+
+// Add the time since checkpoint to the idle total. Called after every wake,
+// at least once a millisecond, so the micros() difference never wraps.
+static void addIdleTime(unsigned long& checkpoint) {
+  unsigned long now = micros();
+  idleMicrosCarry += now - checkpoint;
+  checkpoint = now;
+  idleStats.idleMillis += idleMicrosCarry / 1000;
+  idleMicrosCarry %= 1000;
+}
+
+// Sleep until an input edge or until timeoutMs has passed. Returns true if
+// an input edge woke us. Edges that arrived since the last call count too,
+// so nothing that happened while the caller was busy is missed.
+bool idleWait(unsigned long timeoutMs) {
+  unsigned long checkpoint = micros();
+  unsigned long startMillis = millis();
+  bool woken = false;
+
+  // Latency is measured from the first edge after we start waiting; one
+  // left over from a busy stretch (a game, a long redraw) would skew it
+  noInterrupts();
+  if (!inputEdgePending) {
+    latencyPending = false;
+  }
+  interrupts();
+
+  while (true) {
+    pollInputs();
+    if (inputEdgePending) {
+      idleStats.inputWakes++;
+      woken = true;
+      break;
+    }
+    if (timeoutMs != IDLE_FOREVER && millis() - startMillis >= timeoutMs) {
+      idleStats.deadlineWakes++;
+      break;
+    }
+
+#ifdef HOST_BUILD
+    // Model the sleep on the host: one pass per Timer0 tick
+    delay(1);
+    if (!inputEdgePending) {
+      idleStats.tickWakes++;
+    }
+#else
+    // Check and sleep atomically: an edge between the check and sleep_cpu()
+    // still wakes us, since sei() takes effect after the next instruction
+    noInterrupts();
+    if (!inputEdgePending) {
+      sleep_enable();
+      interrupts();
+      sleep_cpu();
+      sleep_disable();
+      if (!inputEdgePending) {
+        idleStats.tickWakes++;
+      }
+    } else {
+      interrupts();
+    }
+#endif
+    addIdleTime(checkpoint);
+  }
+
+  inputEdgePending = false;
+  addIdleTime(checkpoint);
+  return woken;
+}
+
+// Return and clear an input edge latched since the last wait, without
+// sleeping. For code that polls instead of waiting (the splash), so a tap
+// while it was busy isn't lost.
+bool idleTakeEdge() {
+  pollInputs();
+  noInterrupts();
+  bool edge = inputEdgePending;
+  inputEdgePending = false;
+  interrupts();
+  return edge;
+}
+
+// Sleep for ms milliseconds, input edges don't cut it short
+void idleDelay(unsigned long ms) {
+  unsigned long start = millis();
+  while (millis() - start < ms) {
+    idleWait(ms - (millis() - start));
+  }
+}
+
+// The screen has been redrawn in response to input: record the latency
+// from the edge that woke us
+void idleMarkRedrawn() {
+  if (!latencyPending) {
+    return;
+  }
+  unsigned long latency = micros() - inputEdgeTime;
+  latencyPending = false;
+  idleStats.lastLatencyMicros = latency;
+  idleStats.latencySumMicros += latency;
+  idleStats.latencyCount++;
+  if (latency > idleStats.maxLatencyMicros) {
+    idleStats.maxLatencyMicros = latency;
+  }
+}
+
+// Print the duty cycle and wake latency since the last report
+void idlePrintStats() {
+  unsigned long elapsed = millis() - accountingStart;
+  idleStats.activeMillis = elapsed > idleStats.idleMillis ? elapsed - idleStats.idleMillis : 0;
+
+  Serial.print(F("Idle: active "));
+  Serial.print(idleStats.activeMillis);
+  Serial.print(F(" ms, idle "));
+  Serial.print(idleStats.idleMillis);
+  Serial.print(F(" ms (duty "));
+  Serial.print(elapsed >= 100 ? idleStats.activeMillis / (elapsed / 100) : 0);
+  Serial.print(F("%), wakes: "));
+  Serial.print(idleStats.inputWakes);
+  Serial.print(F(" input, "));
+  Serial.print(idleStats.deadlineWakes);
+  Serial.print(F(" deadline, "));
+  Serial.print(idleStats.tickWakes);
+  Serial.print(F(" tick, "));
+  Serial.print(polledCount);
+  Serial.println(F(" pins polled"));
+
+  Serial.print(F("Wake to redraw: last "));
+  Serial.print(idleStats.lastLatencyMicros);
+  Serial.print(F(" us, max "));
+  Serial.print(idleStats.maxLatencyMicros);
+  Serial.print(F(" us, avg "));
+  Serial.print(idleStats.latencyCount ? idleStats.latencySumMicros / idleStats.latencyCount : 0);
+  Serial.println(F(" us"));
+
+  memset(&idleStats, 0, sizeof(idleStats));
+  idleMicrosCarry = 0;
+  accountingStart = millis();
+}
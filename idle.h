@@ -0,0 +1,45 @@
+#ifndef IDLE_H
+#define IDLE_H
+
+#include "Arduino.h"
+
+// Event-driven idling for the menu and results screens. Instead of spinning
+// on digitalRead(), the CPU sleeps until a pin change on one of the input
+// pins or until a deadline, and keeps count of how long it was active.
+//
+// The sleep mode is IDLE, so millis() keeps running; the Timer0 tick still
+// wakes the CPU once per millisecond for a few microseconds, and those
+// wakes are counted separately from input wakes. Input pins without a pin
+// change interrupt (D4, D5, D8 and D9 on a Mega) are polled on each of
+// those ticks instead. Host builds model the sleep with 1 ms steps and take
+// input edges from idleInjectEdge().
+#define IDLE_FOREVER 0xFFFFFFFFUL   // Same value as TIMER_NO_DEADLINE
+#define IDLE_MAX_POLLED_PINS 8
+
+// Active and idle time are kept in ms, so a board left on the menu all day
+// doesn't overflow them
+struct IdleStats {
+  unsigned long activeMillis;
+  unsigned long idleMillis;
+  unsigned long inputWakes;      // Woken by an input edge
+  unsigned long tickWakes;       // Woken by the Timer0 tick, went back to sleep
+  unsigned long deadlineWakes;   // Returned because the deadline passed
+  unsigned long lastLatencyMicros;   // Input edge to finished redraw
+  unsigned long maxLatencyMicros;
+  unsigned long latencySumMicros;
+  unsigned long latencyCount;
+};
+
+extern IdleStats idleStats;
+
+void idleBegin(const uint8_t* pins, uint8_t pinCount);
+bool idleWait(unsigned long timeoutMs);
+bool idleTakeEdge();
+void idleDelay(unsigned long ms);
+void idleMarkRedrawn();
+void idlePrintStats();
+#ifdef HOST_BUILD
+void idleInjectEdge();
+#endif
+
+#endif
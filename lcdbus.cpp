@@ -0,0 +1,298 @@
+#include "lcdbus.h"
+
+#define LCD_WIDTH 176
+#define LCD_HEIGHT 220
+
+// ILI9225 registers used for window setup
+#define ILI9225_ENTRY_MODE 0x03
+#define ILI9225_RAM_ADDR_SET1 0x20
+#define ILI9225_RAM_ADDR_SET2 0x21
+#define ILI9225_GRAM_DATA_REG 0x22
+#define ILI9225_HORIZONTAL_WINDOW_ADDR1 0x36
+#define ILI9225_HORIZONTAL_WINDOW_ADDR2 0x37
+#define ILI9225_VERTICAL_WINDOW_ADDR1 0x38
+#define ILI9225_VERTICAL_WINDOW_ADDR2 0x39
+
+// Slots in the register shadow
+enum {
+  SHADOW_ENTRY_MODE,
+  SHADOW_H_END,
+  SHADOW_H_START,
+  SHADOW_V_END,
+  SHADOW_V_START,
+  SHADOW_RAM_X,
+  SHADOW_RAM_Y,
+  SHADOW_COUNT
+};
+
+// Bytes the unbatched path spends per primitive: 7 register writes of
+// 4 bytes each plus the GRAM index command
+#define UNBATCHED_WINDOW_BYTES (7 * 4 + 2)
+
+// Pixels clocked out at begin to time the transport
+#define CALIBRATION_PIXELS 128
+
+LcdBusStats lcdBusStats;
+
+static const LcdTransport* transport = &lcdRecorderTransport;
+static uint16_t shadowValue[SHADOW_COUNT];
+static uint8_t shadowValid = 0;       // Bit per shadow slot
+static bool selected = false;
+static bool inFrame = false;
+static bool indexIsGram = false;      // Index register already points at GRAM
+static uint16_t pendingColor = 0;     // Run waiting to be merged or written
+static uint16_t pendingCount = 0;
+
+// Open window and the pixels written into it since the address was set,
+// to work out where the panel's address counter is without reading it back
+static uint8_t windowX0, windowY0, windowX1, windowY1;
+static unsigned long pixelsSinceAddress = 0;
+
+void lcdBusBegin(const LcdTransport* newTransport, uint8_t rs, uint8_t cs, uint8_t sdi, uint8_t clk) {
+  transport = newTransport;
+  transport->begin(rs, cs, sdi, clk);
+  memset(&lcdBusStats, 0, sizeof(lcdBusStats));
+
+  // Time the transport with CS released, so the panel ignores the bytes
+  unsigned long startTime = micros();
+  transport->writeRepeat(0, CALIBRATION_PIXELS);
+  lcdBusStats.nanosPerByte = (micros() - startTime) * 1000 / (2 * CALIBRATION_PIXELS);
+
+  shadowValid = 0;
+  selected = false;
+  inFrame = false;
+  indexIsGram = false;
+  pendingCount = 0;
+  pixelsSinceAddress = 0;
+}
+
+static void select() {
+  if (!selected) {
+    transport->select(true);
+    selected = true;
+    lcdBusStats.transactions++;
+  }
+}
+
+static void deselect() {
+  if (selected) {
+    transport->select(false);
+    selected = false;
+  }
+}
+
+static void flushRun() {
+  if (pendingCount > 0) {
+    transport->writeRepeat(pendingColor, pendingCount);
+    lcdBusStats.bytes += 2UL * pendingCount;
+    pendingCount = 0;
+  }
+}
+
+static void writeCommand(uint8_t command) {
+  flushRun();
+  transport->dataMode(false);
+  transport->write(0x00);
+  transport->write(command);
+  transport->dataMode(true);
+  lcdBusStats.bytes += 2;
+  indexIsGram = (command == ILI9225_GRAM_DATA_REG);
+}
+
+// Write a register unless the panel already holds that value
+static void writeRegister(uint8_t slot, uint8_t command, uint16_t data) {
+  uint8_t bit = 1 << slot;
+  if ((shadowValid & bit) && shadowValue[slot] == data) {
+    lcdBusStats.registerSkips++;
+    return;
+  }
+  writeCommand(command);
+  transport->write(data >> 8);
+  transport->write(data & 0xFF);
+  lcdBusStats.bytes += 2;
+  lcdBusStats.registerWrites++;
+  shadowValue[slot] = data;
+  shadowValid |= bit;
+}
+
+// The TFT library is about to draw on its own: end our transaction and
+// forget the register shadow, since the library rewrites the window
+void lcdInvalidate() {
+  flushRun();
+  deselect();
+  shadowValid = 0;
+  indexIsGram = false;
+  pixelsSinceAddress = 0;
+}
+
+// Keep CS asserted until lcdEndFrame()
+void lcdBeginFrame() {
+  inFrame = true;
+}
+
+void lcdEndFrame() {
+  inFrame = false;
+  lcdRelease();
+}
+
+// Update the address shadow for the pixels written since it was last set.
+// The counter runs left to right, then wraps to the next line of the window.
+static void syncAddressShadow() {
+  if (pixelsSinceAddress == 0) {
+    return;
+  }
+  uint8_t addressBits = (1 << SHADOW_RAM_X) | (1 << SHADOW_RAM_Y);
+  if ((shadowValid & addressBits) == addressBits) {
+    unsigned long width = windowX1 - windowX0 + 1;
+    unsigned long height = windowY1 - windowY0 + 1;
+    unsigned long pos = (shadowValue[SHADOW_RAM_Y] - windowY0) * width
+                      + (shadowValue[SHADOW_RAM_X] - windowX0) + pixelsSinceAddress;
+    pos %= width * height;
+    shadowValue[SHADOW_RAM_X] = windowX0 + pos % width;
+    shadowValue[SHADOW_RAM_Y] = windowY0 + pos / width;
+  }
+  pixelsSinceAddress = 0;
+}
+
+// Point the address counter at (x, y). The panel may load the counter from
+// both address registers whenever either is written, so they always go out
+// as a pair; the pair is skipped only if neither changes.
+static void setAddress(uint8_t x, uint8_t y) {
+  uint8_t addressBits = (1 << SHADOW_RAM_X) | (1 << SHADOW_RAM_Y);
+  if ((shadowValid & addressBits) != addressBits ||
+      shadowValue[SHADOW_RAM_X] != x || shadowValue[SHADOW_RAM_Y] != y) {
+    shadowValid &= ~addressBits;
+  }
+  writeRegister(SHADOW_RAM_X, ILI9225_RAM_ADDR_SET1, x);
+  writeRegister(SHADOW_RAM_Y, ILI9225_RAM_ADDR_SET2, y);
+}
+
+// Set up a window with the address counter at (ramX, ramY), writing only
+// the registers that change, and start a GRAM write
+static void openWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t ramX, uint8_t ramY) {
+  flushRun();
+  select();
+  syncAddressShadow();
+  writeRegister(SHADOW_ENTRY_MODE, ILI9225_ENTRY_MODE, 0x1030);
+  writeRegister(SHADOW_H_END, ILI9225_HORIZONTAL_WINDOW_ADDR1, x1);
+  writeRegister(SHADOW_H_START, ILI9225_HORIZONTAL_WINDOW_ADDR2, x0);
+  writeRegister(SHADOW_V_END, ILI9225_VERTICAL_WINDOW_ADDR1, y1);
+  writeRegister(SHADOW_V_START, ILI9225_VERTICAL_WINDOW_ADDR2, y0);
+  setAddress(ramX, ramY);
+  if (!indexIsGram) {
+    writeCommand(ILI9225_GRAM_DATA_REG);
+  }
+  windowX0 = x0;
+  windowY0 = y0;
+  windowX1 = x1;
+  windowY1 = y1;
+  lcdBusStats.windows++;
+  lcdBusStats.unbatchedTransactions++;
+  lcdBusStats.unbatchedBytes += UNBATCHED_WINDOW_BYTES;
+}
+
+// Open an address window and start a GRAM write at its top left corner
+void lcdSetWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+  openWindow(x0, y0, x1, y1, x0, y0);
+}
+
+// Continue a GRAM write in the open window. The panel keeps its address
+// counter, so this picks up at the next pixel.
+void lcdResume() {
+  select();
+  if (!indexIsGram) {
+    writeCommand(ILI9225_GRAM_DATA_REG);
+  }
+}
+
+// Write count pixels of one color, merged with the previous run if it
+// has the same color
+void lcdWriteRun(uint16_t color, uint16_t count) {
+  if (pendingCount > 0 && (color != pendingColor || pendingCount > 0xFFFF - count)) {
+    flushRun();
+  }
+  pendingColor = color;
+  pendingCount += count;
+  pixelsSinceAddress += count;
+  lcdBusStats.unbatchedBytes += 2UL * count;
+}
+
+// End of a drawing operation. Inside a frame CS stays asserted.
+void lcdRelease() {
+  flushRun();
+  if (!inFrame) {
+    deselect();
+  }
+}
+
+void lcdFillRectangle(int x0, int y0, int x1, int y1, uint16_t color) {
+  if (x0 > x1) { int t = x0; x0 = x1; x1 = t; }
+  if (y0 > y1) { int t = y0; y0 = y1; y1 = t; }
+  x0 = max(x0, 0);
+  y0 = max(y0, 0);
+  x1 = min(x1, LCD_WIDTH - 1);
+  y1 = min(y1, LCD_HEIGHT - 1);
+  if (x0 > x1 || y0 > y1) {
+    return;
+  }
+
+  lcdSetWindow(x0, y0, x1, y1);
+  lcdWriteRun(color, (uint16_t)(x1 - x0 + 1) * (y1 - y0 + 1));
+  lcdRelease();
+}
+
+// Write one span of a circle. The window keeps the circle's full height so
+// the vertical registers never change; only the horizontal range (shared by
+// both spans of a pair) and the address are rewritten.
+static void fillCircleSpan(int xa, int xb, int y, int top, int bottom, uint16_t color) {
+  xa = max(xa, 0);
+  xb = min(xb, LCD_WIDTH - 1);
+  if (xa > xb || y < top || y > bottom) {
+    return;
+  }
+  openWindow(xa, top, xb, bottom, xa, y);
+  lcdWriteRun(color, xb - xa + 1);
+}
+
+// Filled circle as pairs of horizontal spans
+void lcdFillCircle(int x0, int y0, int radius, uint16_t color) {
+  long r2 = (long)radius * radius + radius;   // +r rounds the outline
+  int top = max(y0 - radius, 0);
+  int bottom = min(y0 + radius, LCD_HEIGHT - 1);
+  int dx = radius;
+
+  for (int dy = 0; dy <= radius; dy++) {
+    while ((long)dx * dx + (long)dy * dy > r2) {
+      dx--;
+    }
+    fillCircleSpan(x0 - dx, x0 + dx, y0 - dy, top, bottom, color);
+    if (dy > 0) {
+      fillCircleSpan(x0 - dx, x0 + dx, y0 + dy, top, bottom, color);
+    }
+  }
+  lcdRelease();
+}
+
+void lcdPrintStats() {
+  Serial.print(F("Display bus ("));
+  Serial.print(transport->name);
+  Serial.print(F(", "));
+  Serial.print(lcdBusStats.nanosPerByte);
+  Serial.print(F(" ns/byte): "));
+  Serial.print(lcdBusStats.transactions);
+  Serial.print(F(" transactions / "));
+  Serial.print(lcdBusStats.unbatchedTransactions);
+  Serial.print(F(" unbatched, "));
+  Serial.print(lcdBusStats.bytes);
+  Serial.print(F(" bytes / "));
+  Serial.print(lcdBusStats.unbatchedBytes);
+  Serial.print(F(" unbatched, "));
+  Serial.print(lcdBusStats.bytes / 1000 * lcdBusStats.nanosPerByte / 1000);
+  Serial.print(F(" ms / "));
+  Serial.print(lcdBusStats.unbatchedBytes / 1000 * lcdBusStats.nanosPerByte / 1000);
+  Serial.print(F(" ms unbatched on the wire, "));
+  Serial.print(lcdBusStats.registerSkips);
+  Serial.print(F(" of "));
+  Serial.print(lcdBusStats.registerWrites + lcdBusStats.registerSkips);
+  Serial.println(F(" register writes skipped"));
+}
@@ -0,0 +1,59 @@
+#ifndef LCDBUS_H
+#define LCDBUS_H
+
+#include "Arduino.h"
+
+// Display transport layer for the ILI9225. A transport moves bytes to the
+// panel; the bus on top of it batches drawing into as few transactions as
+// possible:
+//  - CS stays asserted for a whole frame (lcdBeginFrame/lcdEndFrame)
+//  - window and address registers are shadowed, unchanged values are skipped
+//  - consecutive runs of one color are merged into a single repeat write
+//  - writes that continue the open window skip the GRAM index command
+// Portrait orientation only, which is what the game uses after the splash.
+struct LcdTransport {
+  const char* name;
+  void (*begin)(uint8_t rs, uint8_t cs, uint8_t sdi, uint8_t clk);
+  void (*select)(bool selected);     // Chip select
+  void (*dataMode)(bool data);       // RS line: false = command, true = data
+  void (*write)(uint8_t value);
+  void (*writeRepeat)(uint16_t value, uint16_t count);
+};
+
+// Bit-banged on any pins (the current wiring)
+extern const LcdTransport lcdBitBangTransport;
+// Hardware SPI: the display must be wired to MOSI (D11) and SCK (D13)
+extern const LcdTransport lcdHardwareSpiTransport;
+// Talks to no pins, only records the traffic (dry runs and host builds)
+extern const LcdTransport lcdRecorderTransport;
+
+// Wire traffic of the active transport, next to what the same drawing
+// would have cost with one transaction and full window setup per primitive.
+// Only one transport can run per build: bit-bang and hardware SPI need the
+// display on different pins. Compare them by flashing both builds.
+struct LcdBusStats {
+  unsigned long nanosPerByte;    // Measured cost of the transport at begin
+  unsigned long transactions;
+  unsigned long bytes;
+  unsigned long windows;
+  unsigned long registerWrites;
+  unsigned long registerSkips;
+  unsigned long unbatchedTransactions;
+  unsigned long unbatchedBytes;
+};
+
+extern LcdBusStats lcdBusStats;
+
+void lcdBusBegin(const LcdTransport* transport, uint8_t rs, uint8_t cs, uint8_t sdi, uint8_t clk);
+void lcdInvalidate();
+void lcdBeginFrame();
+void lcdEndFrame();
+void lcdSetWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+void lcdResume();
+void lcdWriteRun(uint16_t color, uint16_t count);
+void lcdRelease();
+void lcdFillRectangle(int x0, int y0, int x1, int y1, uint16_t color);
+void lcdFillCircle(int x0, int y0, int radius, uint16_t color);
+void lcdPrintStats();
+
+#endif
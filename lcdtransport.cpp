@@ -0,0 +1,138 @@
+#include "lcdbus.h"
+#include <SPI.h>
+
+// ---- Bit-banged SPI on any four pins ----
+
+// Port registers and masks, so each bit costs a couple of instructions
+// instead of a digitalWrite() call
+static volatile uint8_t* rsPort;
+static volatile uint8_t* csPort;
+static volatile uint8_t* sdiPort;
+static volatile uint8_t* clkPort;
+static uint8_t rsMask, csMask, sdiMask, clkMask;
+
+#define PIN_HIGH(port, mask) (*(port) |= (mask))
+#define PIN_LOW(port, mask) (*(port) &= ~(mask))
+
+static void bitBangBegin(uint8_t rs, uint8_t cs, uint8_t sdi, uint8_t clk) {
+  rsPort = portOutputRegister(digitalPinToPort(rs));
+  csPort = portOutputRegister(digitalPinToPort(cs));
+  sdiPort = portOutputRegister(digitalPinToPort(sdi));
+  clkPort = portOutputRegister(digitalPinToPort(clk));
+  rsMask = digitalPinToBitMask(rs);
+  csMask = digitalPinToBitMask(cs);
+  sdiMask = digitalPinToBitMask(sdi);
+  clkMask = digitalPinToBitMask(clk);
+}
+
+static void bitBangSelect(bool selected) {
+  if (selected) {
+    PIN_LOW(csPort, csMask);
+  } else {
+    PIN_HIGH(csPort, csMask);
+  }
+}
+
+static void bitBangDataMode(bool data) {
+  if (data) {
+    PIN_HIGH(rsPort, rsMask);
+  } else {
+    PIN_LOW(rsPort, rsMask);
+  }
+}
+
+// Clock one byte out, MSB first (SPI mode 0)
+static void bitBangWrite(uint8_t value) {
+  for (uint8_t bit = 0x80; bit; bit >>= 1) {
+    if (value & bit) {
+      PIN_HIGH(sdiPort, sdiMask);
+    } else {
+      PIN_LOW(sdiPort, sdiMask);
+    }
+    PIN_HIGH(clkPort, clkMask);
+    PIN_LOW(clkPort, clkMask);
+  }
+}
+
+static void bitBangWriteRepeat(uint16_t value, uint16_t count) {
+  uint8_t hi = value >> 8;
+  uint8_t lo = value & 0xFF;
+  while (count--) {
+    bitBangWrite(hi);
+    bitBangWrite(lo);
+  }
+}
+
+const LcdTransport lcdBitBangTransport = {
+  "bit-bang", bitBangBegin, bitBangSelect, bitBangDataMode, bitBangWrite, bitBangWriteRepeat
+};
+
+// ---- Hardware SPI (MOSI/SCK fixed, RS and CS on any pin) ----
+
+static volatile uint8_t* hwRsPort;
+static volatile uint8_t* hwCsPort;
+static uint8_t hwRsMask, hwCsMask;
+
+static void hardwareSpiBegin(uint8_t rs, uint8_t cs, uint8_t, uint8_t) {
+  hwRsPort = portOutputRegister(digitalPinToPort(rs));
+  hwCsPort = portOutputRegister(digitalPinToPort(cs));
+  hwRsMask = digitalPinToBitMask(rs);
+  hwCsMask = digitalPinToBitMask(cs);
+  SPI.begin();
+}
+
+static void hardwareSpiSelect(bool selected) {
+  if (selected) {
+    SPI.beginTransaction(SPISettings(8000000, MSBFIRST, SPI_MODE0));
+    PIN_LOW(hwCsPort, hwCsMask);
+  } else {
+    PIN_HIGH(hwCsPort, hwCsMask);
+    SPI.endTransaction();
+  }
+}
+
+static void hardwareSpiDataMode(bool data) {
+  if (data) {
+    PIN_HIGH(hwRsPort, hwRsMask);
+  } else {
+    PIN_LOW(hwRsPort, hwRsMask);
+  }
+}
+
+static void hardwareSpiWrite(uint8_t value) {
+  SPI.transfer(value);
+}
+
+static void hardwareSpiWriteRepeat(uint16_t value, uint16_t count) {
+  uint8_t hi = value >> 8;
+  uint8_t lo = value & 0xFF;
+  while (count--) {
+    SPI.transfer(hi);
+    SPI.transfer(lo);
+  }
+}
+
+const LcdTransport lcdHardwareSpiTransport = {
+  "hardware SPI", hardwareSpiBegin, hardwareSpiSelect, hardwareSpiDataMode, hardwareSpiWrite, hardwareSpiWriteRepeat
+};
+
+// ---- Recorder: no pins, the bus statistics are the whole output ----
+
+static void recorderBegin(uint8_t, uint8_t, uint8_t, uint8_t) {
+}
+
+static void recorderSelect(bool) {
+}
+
+static void recorderDataMode(bool) {
+}
+
+static void recorderWrite(uint8_t) {
+}
+
+static void recorderWriteRepeat(uint16_t, uint16_t) {
+}
+
+const LcdTransport lcdRecorderTransport = {
+  "recorder", recorderBegin, recorderSelect, recorderDataMode, recorderWrite, recorderWriteRepeat
+};
@@ -0,0 +1,236 @@
+#include "leaderboard.h"
+#include "crc8.h"
+
+#include <EEPROM.h>
+
+static uint8_t eepromRead(int address) {
+  return EEPROM.read(address);
+}
+
+static void eepromWrite(int address, uint8_t value) {
+  EEPROM.write(address, value);
+}
+
+LeaderboardIndex leaderboard;
+LeaderboardStats leaderboardStats;
+
+// Record layout (LOG_RECORD_SIZE bytes):
+//   0: magic  1-2: seq (little endian)  3: score1  4: score2
+//   5: game time in seconds  6: reserved  7: CRC-8 of bytes 0-6
+static bool readRecord(uint8_t slot, uint8_t* record) {
+  int address = LOG_BASE_ADDRESS + slot * LOG_RECORD_SIZE;
+  for (uint8_t i = 0; i < LOG_RECORD_SIZE; i++) {
+    record[i] = eepromRead(address + i);
+  }
+  return record[0] == LOG_MAGIC;
+}
+
+// Write a record, only touching bytes that actually change
+static void writeRecord(uint8_t slot, const uint8_t* record) {
+  int address = LOG_BASE_ADDRESS + slot * LOG_RECORD_SIZE;
+  for (uint8_t i = 0; i < LOG_RECORD_SIZE; i++) {
+    if (eepromRead(address + i) != record[i]) {
+      eepromWrite(address + i, record[i]);
+      leaderboardStats.physicalBytes++;
+    }
+  }
+  leaderboardStats.logicalBytes += LOG_RECORD_SIZE;
+}
+
+// Does entry a rank above score / player / seq? Highest score first, then
+// the older match, then player 1. The order doesn't depend on the order
+// scores are inserted in, so appending and the boot scan agree.
+static bool ranksAbove(const HighScore& a, uint8_t score, uint8_t player, uint16_t seq) {
+  if (a.score != score) {
+    return a.score > score;
+  }
+  if (a.seq != seq) {
+    return (int16_t)(a.seq - seq) < 0;
+  }
+  return a.player < player;
+}
+
+// Insert a score into the in-RAM top list (kept sorted, highest first)
+static void insertHighScore(uint8_t score, uint8_t player, uint16_t seq) {
+  int pos = LEADERBOARD_SIZE;
+  while (pos > 0 && (leaderboard.top[pos - 1].player == 0 || !ranksAbove(leaderboard.top[pos - 1], score, player, seq))) {
+    pos--;
+  }
+  if (pos >= LEADERBOARD_SIZE) {
+    return;
+  }
+  for (int i = LEADERBOARD_SIZE - 1; i > pos; i--) {
+    leaderboard.top[i] = leaderboard.top[i - 1];
+  }
+  leaderboard.top[pos].score = score;
+  leaderboard.top[pos].player = player;
+  leaderboard.top[pos].seq = seq;
+}
+
+// Fold one match into the RAM index
+static void indexMatch(uint16_t seq, uint8_t score1, uint8_t score2) {
+  leaderboard.recordCount++;
+  if (score1 > score2) {
+    leaderboard.winsP1++;
+  } else if (score2 > score1) {
+    leaderboard.winsP2++;
+  } else {
+    leaderboard.ties++;
+  }
+  insertHighScore(score1, 1, seq);
+  insertHighScore(score2, 2, seq);
+}
+
+// Is the record in a slot valid? Torn or worn-out records fail the CRC.
+static bool readValidRecord(uint8_t slot, uint8_t* record) {
+  return readRecord(slot, record) && crc8(record, LOG_RECORD_SIZE - 1) == record[LOG_RECORD_SIZE - 1];
+}
+
+// Rebuild the top list from the records still in the log
+static void rebuildHighScores() {
+  uint8_t record[LOG_RECORD_SIZE];
+  memset(leaderboard.top, 0, sizeof(leaderboard.top));
+  for (uint8_t slot = 0; slot < LOG_SLOTS; slot++) {
+    if (readValidRecord(slot, record)) {
+      uint16_t seq = record[1] | (record[2] << 8);
+      insertHighScore(record[3], 1, seq);
+      insertHighScore(record[4], 2, seq);
+    }
+  }
+}
+
+// Rebuild the RAM index with one bounded pass over the log
+void leaderboardBegin() {
+  unsigned long startTime = micros();
+  memset(&leaderboard, 0, sizeof(leaderboard));
+  memset(&leaderboardStats, 0, sizeof(leaderboardStats));
+
+  uint8_t record[LOG_RECORD_SIZE];
+  bool found = false;
+  uint16_t newestSeq = 0;
+  uint8_t newestSlot = 0;
+
+  for (uint8_t slot = 0; slot < LOG_SLOTS; slot++) {
+    leaderboardStats.slotsScanned++;
+    if (!readRecord(slot, record)) {
+      continue;
+    }
+    if (crc8(record, LOG_RECORD_SIZE - 1) != record[LOG_RECORD_SIZE - 1]) {
+      // Torn or worn-out record, skip it
+      leaderboardStats.corruptSlots++;
+      continue;
+    }
+
+    uint16_t seq = record[1] | (record[2] << 8);
+    indexMatch(seq, record[3], record[4]);
+
+    // Sequence numbers wrap, so compare them as a signed difference
+    if (!found || (int16_t)(seq - newestSeq) > 0) {
+      found = true;
+      newestSeq = seq;
+      newestSlot = slot;
+      leaderboard.lastScore1 = record[3];
+      leaderboard.lastScore2 = record[4];
+    }
+  }
+
+  if (found) {
+    leaderboard.nextSeq = newestSeq + 1;
+    leaderboard.headSlot = (newestSlot + 1) % LOG_SLOTS;
+  } else {
+    leaderboard.nextSeq = 1;
+    leaderboard.headSlot = 0;
+  }
+
+  leaderboardStats.bootScanMicros = micros() - startTime;
+}
+
+// Append a finished match to the log and update the RAM index
+void leaderboardRecordMatch(int score1, int score2, int gameTime) {
+  uint8_t record[LOG_RECORD_SIZE];
+  uint8_t s1 = constrain(score1, 0, 255);
+  uint8_t s2 = constrain(score2, 0, 255);
+
+  // The slot being overwritten drops out of the history window
+  uint8_t old[LOG_RECORD_SIZE];
+  bool evicted = readValidRecord(leaderboard.headSlot, old);
+  if (evicted) {
+    leaderboard.recordCount--;
+    if (old[3] > old[4]) {
+      leaderboard.winsP1--;
+    } else if (old[4] > old[3]) {
+      leaderboard.winsP2--;
+    } else {
+      leaderboard.ties--;
+    }
+  }
+
+  record[0] = LOG_MAGIC;
+  record[1] = leaderboard.nextSeq & 0xFF;
+  record[2] = leaderboard.nextSeq >> 8;
+  record[3] = s1;
+  record[4] = s2;
+  record[5] = constrain(gameTime, 0, 255);
+  record[6] = 0;
+  record[7] = crc8(record, LOG_RECORD_SIZE - 1);
+  writeRecord(leaderboard.headSlot, record);
+
+  indexMatch(leaderboard.nextSeq, s1, s2);
+  if (evicted) {
+    // The evicted match may hold one of the high scores. Rebuild the list
+    // from the log so it matches what the next boot will find.
+    rebuildHighScores();
+  }
+  leaderboard.lastScore1 = s1;
+  leaderboard.lastScore2 = s2;
+  leaderboard.nextSeq++;
+  leaderboard.headSlot = (leaderboard.headSlot + 1) % LOG_SLOTS;
+  leaderboardStats.recordsAppended++;
+}
+
+// Best score ever recorded, O(1) from the RAM index
+uint8_t leaderboardBestScore() {
+  return leaderboard.top[0].score;
+}
+
+// Print the index and the boot / wear measurements
+void leaderboardPrintStats() {
+  Serial.print(F("Leaderboard: "));
+  Serial.print(leaderboard.recordCount);
+  Serial.print(F(" matches, next slot "));
+  Serial.print(leaderboard.headSlot);
+  Serial.print(F(", P1 wins "));
+  Serial.print(leaderboard.winsP1);
+  Serial.print(F(", P2 wins "));
+  Serial.print(leaderboard.winsP2);
+  Serial.print(F(", ties "));
+  Serial.println(leaderboard.ties);
+
+  for (int i = 0; i < LEADERBOARD_SIZE && leaderboard.top[i].player != 0; i++) {
+    Serial.print(F("  #"));
+    Serial.print(i + 1);
+    Serial.print(F(" P"));
+    Serial.print(leaderboard.top[i].player);
+    Serial.print(' ');
+    Serial.println(leaderboard.top[i].score);
+  }
+
+  Serial.print(F("Boot scan: "));
+  Serial.print(leaderboardStats.slotsScanned);
+  Serial.print(F(" slots in "));
+  Serial.print(leaderboardStats.bootScanMicros);
+  Serial.print(F(" us, corrupt "));
+  Serial.println(leaderboardStats.corruptSlots);
+
+  // Write amplification: bytes rewritten per record byte appended. Each slot
+  // is only reused once every LOG_SLOTS appends.
+  Serial.print(F("EEPROM writes: "));
+  Serial.print(leaderboardStats.physicalBytes);
+  Serial.print(F(" / "));
+  Serial.print(leaderboardStats.logicalBytes);
+  Serial.print(F(" bytes over "));
+  Serial.print(leaderboardStats.recordsAppended);
+  Serial.print(F(" appends, cell reuse every "));
+  Serial.print(LOG_SLOTS);
+  Serial.println(F(" matches"));
+}
@@ -0,0 +1,54 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include "Arduino.h"
+
+// Match history is kept as an append-only log of fixed-size records spread
+// over the whole EEPROM. Each append goes to the slot after the newest record,
+// so every cell is rewritten only once per LOG_SLOTS matches instead of after
+// every game.
+#define LOG_BASE_ADDRESS 0
+#define LOG_RECORD_SIZE 8
+#define LOG_SLOTS 128          // 128 * 8 bytes = 1 KB (full Uno EEPROM)
+#define LOG_MAGIC 0xB5
+#define LEADERBOARD_SIZE 5     // Number of high scores kept in RAM
+
+// One high score entry in the RAM index
+struct HighScore {
+  uint8_t score;
+  uint8_t player;   // 1 or 2, 0 if the entry is unused
+  uint16_t seq;     // Sequence number of the match it came from
+};
+
+// Compact RAM index, rebuilt from the log at boot
+struct LeaderboardIndex {
+  uint16_t nextSeq;        // Sequence number for the next append
+  uint8_t headSlot;        // Slot the next record will be written to
+  uint8_t recordCount;     // Valid records found in the log
+  uint8_t winsP1;
+  uint8_t winsP2;
+  uint8_t ties;
+  uint8_t lastScore1;      // Scores of the most recent match
+  uint8_t lastScore2;
+  HighScore top[LEADERBOARD_SIZE];
+};
+
+// Measurements reported over Serial
+struct LeaderboardStats {
+  unsigned long bootScanMicros;   // Time spent rebuilding the index
+  uint16_t slotsScanned;
+  uint16_t corruptSlots;          // Slots holding a record with a bad CRC
+  unsigned long recordsAppended;
+  unsigned long logicalBytes;     // Record bytes requested by appends
+  unsigned long physicalBytes;    // Bytes actually rewritten in EEPROM
+};
+
+extern LeaderboardIndex leaderboard;
+extern LeaderboardStats leaderboardStats;
+
+void leaderboardBegin();
+void leaderboardRecordMatch(int score1, int score2, int gameTime);
+uint8_t leaderboardBestScore();
+void leaderboardPrintStats();
+
+#endif
@@ -0,0 +1,41 @@
+#include "rle.h"
+
+void rleBegin(RleDecoder* decoder, const RleAsset* asset) {
+  decoder->asset = asset;
+  decoder->offset = 0;
+  decoder->runLength = 0;
+  decoder->runColor = 0;
+}
+
+// Emit up to `pixels` pixels through the sink, straight from flash.
+// Returns the number of pixels emitted (less at the end of the image).
+uint16_t rleDecode(RleDecoder* decoder, uint16_t pixels, RleSink sink) {
+  const RleAsset* asset = decoder->asset;
+  uint16_t emitted = 0;
+
+  while (emitted < pixels) {
+    // Fetch the next run when the current one is used up
+    if (decoder->runLength == 0) {
+      if (decoder->offset >= asset->dataSize) {
+        break;
+      }
+      uint8_t token = pgm_read_byte(asset->data + decoder->offset++);
+      uint8_t length = token & 0x0F;
+      if (length < 15) {
+        decoder->runLength = length + 1;
+      } else {
+        decoder->runLength = 16 + pgm_read_byte(asset->data + decoder->offset++);
+      }
+      decoder->runColor = pgm_read_word(asset->palette + (token >> 4));
+    }
+
+    uint16_t count = decoder->runLength;
+    if (count > pixels - emitted) {
+      count = pixels - emitted;
+    }
+    sink(decoder->runColor, count);
+    decoder->runLength -= count;
+    emitted += count;
+  }
+  return emitted;
+}
@@ -0,0 +1,36 @@
+#ifndef RLE_H
+#define RLE_H
+
+#include "Arduino.h"
+
+// Palette + run-length compressed screen image, generated by
+// tools/rle_encode.py. The palette and run data live in PROGMEM.
+//
+// Run data is a stream of tokens, one per run, in raster order:
+//   high nibble: palette index
+//   low nibble:  run length - 1 (1..15 pixels), or 15 for a long run whose
+//                length is 16 + the next byte (16..271 pixels)
+struct RleAsset {
+  uint8_t width;
+  uint8_t height;
+  uint8_t paletteSize;
+  const uint16_t* palette;
+  const uint8_t* data;
+  uint16_t dataSize;
+};
+
+// Receives decoded pixels as runs of one color
+typedef void (*RleSink)(uint16_t color, uint16_t count);
+
+// Streaming decoder state, so an image can be emitted in several parts
+struct RleDecoder {
+  const RleAsset* asset;
+  uint16_t offset;      // Next token in asset->data
+  uint16_t runLength;   // Pixels left in the current run
+  uint16_t runColor;
+};
+
+void rleBegin(RleDecoder* decoder, const RleAsset* asset);
+uint16_t rleDecode(RleDecoder* decoder, uint16_t pixels, RleSink sink);
+
+#endif
@@ -0,0 +1,254 @@
+#include "screen.h"
+
+#define SCREEN_WIDTH 176
+#define SCREEN_HEIGHT 220
+#define SCREEN_BACKGROUND COLOR_BLACK
+
+enum {
+  PRIM_TEXT,
+  PRIM_RECTANGLE,   // Outline
+  PRIM_LINE,        // Horizontal or vertical
+  PRIM_AREA         // Drawn outside the lists, only ever erased
+};
+
+struct ScreenPrim {
+  uint8_t kind;
+  uint8_t x1, y1, x2, y2;   // Bounding box, inclusive
+  uint16_t color;
+  uint8_t* font;
+  uint8_t text;             // Offset of the copied string in textPool
+  bool keep;                // Old: also on the new screen. New: already on the panel.
+};
+
+// Screen names for the stats, kept in flash
+static const char nameMenu[] PROGMEM = "menu";
+static const char nameGameStarts[] PROGMEM = "gameStarts";
+static const char nameGame[] PROGMEM = "game";
+static const char nameResults[] PROGMEM = "results";
+static const char namePlayAgain[] PROGMEM = "playAgain";
+static const char nameThankYou[] PROGMEM = "thankYou";
+
+static const char* const screenNames[SCREEN_COUNT] PROGMEM = {
+  nameMenu, nameGameStarts, nameGame, nameResults, namePlayAgain, nameThankYou
+};
+
+ScreenStats screenStats;
+
+// The panel's screen in [0, oldCount), the one being built after it
+static ScreenPrim prims[SCREEN_MAX_PRIMS];
+static uint8_t oldCount = 0;
+static uint8_t primCount = 0;
+static uint8_t newScreen = 0;
+
+// Copies of the strings, the panel's in [0, oldTextUsed), then the new
+// screen's
+static char textPool[SCREEN_TEXT_POOL];
+static uint8_t oldTextUsed = 0;
+static uint8_t textUsed = 0;
+
+void screenBegin(uint8_t id) {
+  newScreen = id;
+  primCount = oldCount;
+  textUsed = oldTextUsed;
+}
+
+static ScreenPrim* addPrim(uint8_t kind, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint16_t color) {
+  if (primCount == SCREEN_MAX_PRIMS) {
+    screenStats.overflows++;
+    return NULL;
+  }
+  ScreenPrim* prim = &prims[primCount++];
+  prim->kind = kind;
+  prim->x1 = min(x1, x2);
+  prim->y1 = min(y1, y2);
+  prim->x2 = min(max(x1, x2), SCREEN_WIDTH - 1);
+  prim->y2 = min(max(y1, y2), SCREEN_HEIGHT - 1);
+  prim->color = color;
+  prim->font = NULL;
+  prim->text = 0;
+  prim->keep = false;
+  return prim;
+}
+
+void screenText(uint8_t x, uint8_t y, const char* text, uint16_t color, uint8_t* font) {
+  // The library advances one column past each glyph
+  uint8_t width = pgm_read_byte(&font[0]) + 1;
+  uint8_t height = pgm_read_byte(&font[1]);
+  uint8_t length = strlen(text);
+  if (textUsed + length + 1 > SCREEN_TEXT_POOL) {
+    screenStats.overflows++;
+    return;
+  }
+  ScreenPrim* prim = addPrim(PRIM_TEXT, x, y, min(x + length * width - 1, 255), y + height - 1, color);
+  if (prim == NULL) {
+    return;
+  }
+  prim->font = font;
+  prim->text = textUsed;
+  memcpy(textPool + textUsed, text, length + 1);
+  textUsed += length + 1;
+}
+
+void screenRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint16_t color) {
+  addPrim(PRIM_RECTANGLE, x1, y1, x2, y2, color);
+}
+
+void screenLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint16_t color) {
+  addPrim(PRIM_LINE, x1, y1, x2, y2, color);
+}
+
+void screenArea(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2) {
+  addPrim(PRIM_AREA, x1, y1, x2, y2, SCREEN_BACKGROUND);
+}
+
+static bool samePrim(const ScreenPrim& a, const ScreenPrim& b) {
+  return a.kind == b.kind && a.x1 == b.x1 && a.y1 == b.y1 && a.x2 == b.x2 && a.y2 == b.y2 &&
+         a.color == b.color && a.font == b.font &&
+         (a.kind != PRIM_TEXT || strcmp(textPool + a.text, textPool + b.text) == 0);
+}
+
+static bool overlaps(const ScreenPrim& a, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2) {
+  return a.x1 <= x2 && x1 <= a.x2 && a.y1 <= y2 && y1 <= a.y2;
+}
+
+// Does drawing or erasing prim touch other's pixels? Outlines only cover
+// their edges, not the inside of their box.
+static bool touches(const ScreenPrim& prim, const ScreenPrim& other) {
+  if (prim.kind != PRIM_RECTANGLE) {
+    return overlaps(other, prim.x1, prim.y1, prim.x2, prim.y2);
+  }
+  return overlaps(other, prim.x1, prim.y1, prim.x2, prim.y1) ||
+         overlaps(other, prim.x1, prim.y2, prim.x2, prim.y2) ||
+         overlaps(other, prim.x1, prim.y1, prim.x1, prim.y2) ||
+         overlaps(other, prim.x2, prim.y1, prim.x2, prim.y2);
+}
+
+static unsigned long primPixels(const ScreenPrim& prim) {
+  unsigned long width = prim.x2 - prim.x1 + 1;
+  unsigned long height = prim.y2 - prim.y1 + 1;
+  if (prim.kind == PRIM_RECTANGLE) {
+    return 2 * (width + height);
+  }
+  return width * height;
+}
+
+static void drawPrim(GameTFT& tft, const ScreenPrim& prim, uint16_t color) {
+  switch (prim.kind) {
+    case PRIM_TEXT:
+      if (color == prim.color) {
+        tft.setFont(prim.font);
+        tft.drawText(prim.x1, prim.y1, textPool + prim.text, color);
+      } else {
+        tft.fillRectangle(prim.x1, prim.y1, prim.x2, prim.y2, color);
+      }
+      break;
+    case PRIM_RECTANGLE:
+      tft.fillRectangle(prim.x1, prim.y1, prim.x2, prim.y1, color);
+      tft.fillRectangle(prim.x1, prim.y2, prim.x2, prim.y2, color);
+      tft.fillRectangle(prim.x1, prim.y1, prim.x1, prim.y2, color);
+      tft.fillRectangle(prim.x2, prim.y1, prim.x2, prim.y2, color);
+      break;
+    case PRIM_LINE:
+      tft.fillRectangle(prim.x1, prim.y1, prim.x2, prim.y2, color);
+      break;
+    case PRIM_AREA:
+      if (color == SCREEN_BACKGROUND) {
+        tft.fillRectangle(prim.x1, prim.y1, prim.x2, prim.y2, color);
+      }
+      break;
+  }
+}
+
+// Show the screen built since screenBegin(). Returns the pixels written.
+unsigned long screenEnd(GameTFT& tft) {
+  ScreenPrim* newPrims = prims + oldCount;
+  uint8_t newCount = primCount - oldCount;
+  unsigned long pixels = 0;
+  unsigned long fullPixels = (unsigned long)SCREEN_WIDTH * SCREEN_HEIGHT;
+
+  // Pair up primitives that are on both screens
+  for (uint8_t i = 0; i < oldCount; i++) {
+    prims[i].keep = false;
+  }
+  for (uint8_t n = 0; n < newCount; n++) {
+    for (uint8_t i = 0; i < oldCount; i++) {
+      if (!prims[i].keep && samePrim(prims[i], newPrims[n])) {
+        prims[i].keep = true;
+        newPrims[n].keep = true;
+        break;
+      }
+    }
+  }
+
+  // Erase what only the old screen had. A kept primitive it touches has
+  // to be drawn again.
+  for (uint8_t i = 0; i < oldCount; i++) {
+    if (prims[i].keep) {
+      continue;
+    }
+    drawPrim(tft, prims[i], SCREEN_BACKGROUND);
+    pixels += primPixels(prims[i]);
+    for (uint8_t n = 0; n < newCount; n++) {
+      if (newPrims[n].keep && touches(prims[i], newPrims[n])) {
+        newPrims[n].keep = false;
+      }
+    }
+  }
+
+  // Draw in list order. Drawing a primitive can cover a kept one further
+  // down the list, which then has to go on top again.
+  for (uint8_t n = 0; n < newCount; n++) {
+    if (newPrims[n].kind != PRIM_AREA) {
+      fullPixels += primPixels(newPrims[n]);
+    }
+    if (newPrims[n].keep) {
+      continue;
+    }
+    drawPrim(tft, newPrims[n], newPrims[n].color);
+    if (newPrims[n].kind != PRIM_AREA) {
+      pixels += primPixels(newPrims[n]);
+      for (uint8_t later = n + 1; later < newCount; later++) {
+        if (newPrims[later].keep && touches(newPrims[n], newPrims[later])) {
+          newPrims[later].keep = false;
+        }
+      }
+    }
+  }
+
+  // The new screen becomes the old one, texts included
+  memmove(prims, newPrims, newCount * sizeof(ScreenPrim));
+  oldCount = newCount;
+  primCount = newCount;
+  for (uint8_t i = 0; i < newCount; i++) {
+    if (prims[i].kind == PRIM_TEXT) {
+      prims[i].text -= oldTextUsed;
+    }
+  }
+  memmove(textPool, textPool + oldTextUsed, textUsed - oldTextUsed);
+  textUsed -= oldTextUsed;
+  oldTextUsed = textUsed;
+
+  screenStats.pixels[newScreen] = pixels;
+  screenStats.fullPixels[newScreen] = fullPixels;
+  screenStats.transitions++;
+  return pixels;
+}
+
+// Pixels written by the last transition into each screen, next to a full
+// clear and redraw of the same screen
+void screenPrintStats() {
+  Serial.print(F("Screens (px written / full redraw):"));
+  for (uint8_t i = 0; i < SCREEN_COUNT; i++) {
+    Serial.print(' ');
+    Serial.print((const __FlashStringHelper*)pgm_read_ptr(&screenNames[i]));
+    Serial.print(' ');
+    Serial.print(screenStats.pixels[i]);
+    Serial.print('/');
+    Serial.print(screenStats.fullPixels[i]);
+  }
+  if (screenStats.overflows > 0) {
+    Serial.print(F(", overflows "));
+    Serial.print(screenStats.overflows);
+  }
+  Serial.println();
+}
@@ -0,0 +1,52 @@
+#ifndef SCREEN_H
+#define SCREEN_H
+
+#include "Arduino.h"
+#include "display.h"
+
+// Retained screens. Each screen is described as a list of primitives
+// between screenBegin() and screenEnd() instead of being drawn straight
+// away. screenEnd() compares the list with the one on the panel: it erases
+// what only the old screen had, then draws what is new, plus anything kept
+// that the erasing touched. Nothing is cleared as a whole.
+//
+// Text is copied into a pool when it is added, so the caller's string can
+// be a temporary. The panel's texts stay in the pool until the next screen
+// replaces them. Content drawn outside the lists (balls, coins, scores) is
+// covered with screenArea() so the next screen erases it.
+// Sized for the largest transition, menu to menu: 16 primitives and 142
+// text bytes.
+#define SCREEN_MAX_PRIMS 16   // Old and new screen together
+#define SCREEN_TEXT_POOL 142  // Text bytes, old and new screen together
+#if SCREEN_TEXT_POOL > 255
+#error "SCREEN_TEXT_POOL must fit the 8-bit text offsets"
+#endif
+
+enum ScreenId {
+  SCREEN_MENU,
+  SCREEN_GAME_STARTS,
+  SCREEN_GAME,
+  SCREEN_RESULTS,
+  SCREEN_PLAY_AGAIN,
+  SCREEN_THANK_YOU,
+  SCREEN_COUNT
+};
+
+struct ScreenStats {
+  unsigned long pixels[SCREEN_COUNT];       // Last transition into each screen
+  unsigned long fullPixels[SCREEN_COUNT];   // Same transition as clear + redraw
+  unsigned long transitions;
+  unsigned long overflows;                  // Primitives dropped, list or pool full
+};
+
+extern ScreenStats screenStats;
+
+void screenBegin(uint8_t id);
+void screenText(uint8_t x, uint8_t y, const char* text, uint16_t color, uint8_t* font);
+void screenRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint16_t color);
+void screenLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint16_t color);
+void screenArea(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
+unsigned long screenEnd(GameTFT& tft);
+void screenPrintStats();
+
+#endif
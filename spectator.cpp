@@ -0,0 +1,214 @@
+#include "spectator.h"
+#include "crc8.h"
+
+#define SPECTATOR_SYNC 0xA5
+#define SPECTATOR_MAX_PAYLOAD 40
+
+// Change mask bits of a delta frame
+#define CHANGE_BALL1 0x01
+#define CHANGE_BALL2 0x02
+#define CHANGE_SCORE1 0x04
+#define CHANGE_SCORE2 0x08
+#define CHANGE_TIME 0x10
+#define CHANGE_COINS 0x20
+#define CHANGE_BALL1_LONG 0x40   // With CHANGE_BALL1: moved more than 7 pixels
+#define CHANGE_BALL2_LONG 0x80
+
+SpectatorStats spectatorStats;
+
+static SpectatorSnapshot lastSent;   // State the receiver has
+static bool needKeyframe = true;
+static uint8_t ticksSinceKeyframe = 0;
+static uint8_t nextSeq = 0;
+
+// Frame being built
+static uint8_t frame[SPECTATOR_MAX_PAYLOAD + 4];
+static uint8_t frameLength = 0;
+
+void spectatorBegin() {
+  memset(&spectatorStats, 0, sizeof(spectatorStats));
+  needKeyframe = true;
+  ticksSinceKeyframe = 0;
+}
+
+static void putByte(uint8_t value) {
+  frame[frameLength++] = value;
+}
+
+static void putVarint(uint16_t value) {
+  while (value >= 0x80) {
+    putByte((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  putByte(value);
+}
+
+// Signed values as varints: 0, -1, 1, -2, ... map to 0, 1, 2, 3, ...
+static uint16_t zigzag(int value) {
+  return value < 0 ? ((uint16_t)(-value) << 1) - 1 : (uint16_t)value << 1;
+}
+
+static void startFrame(uint8_t type) {
+  frameLength = 0;
+  putByte(SPECTATOR_SYNC);
+  putByte((type << 6) | (nextSeq & 0x3F));
+  putByte(0);   // Payload length, filled in by finishFrame()
+}
+
+// Close the frame and send it if the serial buffer has room for all of it;
+// never block the game on the link. Returns false if the frame was dropped.
+static bool finishFrame() {
+  frame[2] = frameLength - 3;
+  putByte(crc8(frame + 1, frameLength - 1));
+
+  if (Serial.availableForWrite() < frameLength) {
+    spectatorStats.dropped++;
+    return false;
+  }
+  Serial.write(frame, frameLength);
+  spectatorStats.bytesSent += frameLength;
+  nextSeq++;
+  return true;
+}
+
+static void putKeyframe(const SpectatorSnapshot& s) {
+  startFrame(SPECTATOR_KEYFRAME);
+  for (uint8_t i = 0; i < 2; i++) {
+    putByte(s.ballX[i]);
+    putByte(s.ballY[i]);
+  }
+  putVarint(s.score[0]);
+  putVarint(s.score[1]);
+  putByte(s.remainingTime);
+  putByte(s.coinActive);
+  for (uint8_t i = 0; i < SPECTATOR_MAX_COINS; i++) {
+    if (s.coinActive & (1 << i)) {
+      putByte(s.coinX[i]);
+      putByte(s.coinY[i]);
+    }
+  }
+  putVarint(spectatorStats.dropped > 0xFFFF ? 0xFFFF : spectatorStats.dropped);
+}
+
+static uint8_t varintSize(uint16_t value) {
+  return value < 0x80 ? 1 : (value < 0x4000 ? 2 : 3);
+}
+
+// Length of putKeyframe()'s frame with CRC, without building it
+static uint8_t keyframeSize(const SpectatorSnapshot& s) {
+  uint8_t size = 3 + 4 + varintSize(s.score[0]) + varintSize(s.score[1]) + 2 + 1;
+  for (uint8_t i = 0; i < SPECTATOR_MAX_COINS; i++) {
+    if (s.coinActive & (1 << i)) {
+      size += 2;
+    }
+  }
+  return size + varintSize(spectatorStats.dropped > 0xFFFF ? 0xFFFF : spectatorStats.dropped);
+}
+
+static uint8_t putBallDelta(const SpectatorSnapshot& s, uint8_t ball, uint8_t changed, uint8_t isLong) {
+  int dx = s.ballX[ball] - lastSent.ballX[ball];
+  int dy = s.ballY[ball] - lastSent.ballY[ball];
+  if (dx == 0 && dy == 0) {
+    return 0;
+  }
+  uint16_t zx = zigzag(dx);
+  uint16_t zy = zigzag(dy);
+  if (zx < 16 && zy < 16) {
+    putByte((zy << 4) | zx);
+    return changed;
+  }
+  putVarint(zx);
+  putVarint(zy);
+  return changed | isLong;
+}
+
+// Delta against lastSent. Fields go out in mask bit order; the mask byte
+// is written first and patched once all fields are known.
+static void putDelta(const SpectatorSnapshot& s) {
+  startFrame(SPECTATOR_DELTA);
+  uint8_t maskPos = frameLength;
+  putByte(0);
+
+  uint8_t mask = 0;
+  mask |= putBallDelta(s, 0, CHANGE_BALL1, CHANGE_BALL1_LONG);
+  mask |= putBallDelta(s, 1, CHANGE_BALL2, CHANGE_BALL2_LONG);
+  if (s.score[0] != lastSent.score[0]) {
+    putVarint(zigzag(s.score[0] - lastSent.score[0]));
+    mask |= CHANGE_SCORE1;
+  }
+  if (s.score[1] != lastSent.score[1]) {
+    putVarint(zigzag(s.score[1] - lastSent.score[1]));
+    mask |= CHANGE_SCORE2;
+  }
+  if (s.remainingTime != lastSent.remainingTime) {
+    putVarint(zigzag(s.remainingTime - lastSent.remainingTime));
+    mask |= CHANGE_TIME;
+  }
+
+  // A slot changes when its coin appears, disappears or is replaced
+  uint8_t changedSlots = s.coinActive ^ lastSent.coinActive;
+  for (uint8_t i = 0; i < SPECTATOR_MAX_COINS; i++) {
+    uint8_t bit = 1 << i;
+    if ((s.coinActive & lastSent.coinActive & bit) &&
+        (s.coinX[i] != lastSent.coinX[i] || s.coinY[i] != lastSent.coinY[i])) {
+      changedSlots |= bit;
+    }
+  }
+  if (changedSlots) {
+    putByte((s.coinActive << 4) | changedSlots);
+    for (uint8_t i = 0; i < SPECTATOR_MAX_COINS; i++) {
+      uint8_t bit = 1 << i;
+      if (changedSlots & s.coinActive & bit) {
+        putByte(s.coinX[i]);
+        putByte(s.coinY[i]);
+      }
+    }
+    mask |= CHANGE_COINS;
+  }
+
+  frame[maskPos] = mask;
+}
+
+// Send one tick of match state. After a dropped frame the receiver's state
+// is unknown, so the next frame is a keyframe.
+void spectatorSend(const SpectatorSnapshot& snapshot) {
+  // Cost of the same tick as a keyframe, for the compression ratio
+  spectatorStats.keyframeBytes += keyframeSize(snapshot);
+
+  bool keyframe = needKeyframe || ticksSinceKeyframe >= SPECTATOR_KEYFRAME_TICKS;
+  if (keyframe) {
+    putKeyframe(snapshot);
+  } else {
+    if (memcmp(&snapshot, &lastSent, sizeof(snapshot)) == 0) {
+      ticksSinceKeyframe++;
+      return;   // Nothing changed, nothing to send
+    }
+    putDelta(snapshot);
+  }
+
+  if (!finishFrame()) {
+    needKeyframe = true;
+    return;
+  }
+  if (keyframe) {
+    spectatorStats.keyframes++;
+    ticksSinceKeyframe = 0;
+    needKeyframe = false;
+  } else {
+    spectatorStats.deltas++;
+    ticksSinceKeyframe++;
+  }
+  lastSent = snapshot;
+}
+
+// Tell the receiver the match is over. Waits for room in the buffer, this
+// is sent once after the game loop.
+void spectatorEnd() {
+  startFrame(SPECTATOR_END);
+  frame[2] = 0;
+  putByte(crc8(frame + 1, frameLength - 1));
+  Serial.write(frame, frameLength);
+  spectatorStats.bytesSent += frameLength;
+  nextSeq++;
+  needKeyframe = true;
+}
@@ -0,0 +1,63 @@
+#ifndef SPECTATOR_H
+#define SPECTATOR_H
+
+#include "Arduino.h"
+
+// Spectator stream: live match state sent over Serial for a PC to show on
+// a big screen (tools/spectator_decode.py). Every SPECTATOR_TICK_MS the
+// game hands over a snapshot; a keyframe carries the full state, the ticks
+// in between send only what changed since the last frame that went out.
+//
+// Frame:   0xA5, header (type << 6 | seq), payload length, payload, CRC-8
+// Delta:   change mask, then per flagged field in mask order:
+//            ball (short)  one byte, zigzag dx in the low nibble, dy high
+//            ball (long)   zigzag varint dx, zigzag varint dy
+//            score         zigzag varint change
+//            time          zigzag varint change
+//            coins         changed slots (low nibble), active slots (high
+//                          nibble), then x, y of each changed active slot
+// Keyframe: x, y of both balls, score varints, time, active slot mask,
+//           x, y of each active coin, varint count of frames dropped so far
+//
+// Build with SPECTATOR_ENABLED 1 to turn it on. It shares the serial link
+// with the debug output and the trace stream, so both are off meanwhile.
+#ifndef SPECTATOR_ENABLED
+#define SPECTATOR_ENABLED 0
+#endif
+
+#define SPECTATOR_BAUD 9600
+#define SPECTATOR_TICK_MS 30          // About 33 updates per second
+#define SPECTATOR_KEYFRAME_TICKS 64   // Full state at least every ~2 seconds
+#define SPECTATOR_MAX_COINS 4         // Coin slots fit in one nibble
+
+enum SpectatorFrameType {
+  SPECTATOR_KEYFRAME,
+  SPECTATOR_DELTA,
+  SPECTATOR_END            // Match over, no payload
+};
+
+struct SpectatorSnapshot {
+  uint8_t ballX[2];
+  uint8_t ballY[2];
+  uint16_t score[2];
+  uint8_t remainingTime;
+  uint8_t coinActive;      // Bit per coin slot
+  uint8_t coinX[SPECTATOR_MAX_COINS];
+  uint8_t coinY[SPECTATOR_MAX_COINS];
+};
+
+struct SpectatorStats {
+  unsigned long keyframes;
+  unsigned long deltas;
+  unsigned long dropped;         // No room in the serial buffer
+  unsigned long bytesSent;
+  unsigned long keyframeBytes;   // What sending keyframes only would have cost
+};
+
+extern SpectatorStats spectatorStats;
+
+void spectatorBegin();
+void spectatorSend(const SpectatorSnapshot& snapshot);
+void spectatorEnd();
+
+#endif
@@ -0,0 +1,118 @@
+// Generated by tools/rle_encode.py, do not edit.
+// 176x220, 6 colors, 1616 bytes of runs (77440 bytes uncompressed)
+#ifndef ASSET_SPLASHSHAPES_H
+#define ASSET_SPLASHSHAPES_H
+
+#include "rle.h"
+
+const uint16_t splashShapes_palette[] PROGMEM = {
+  0xFFFF, 0x0000, 0xF800, 0x001F, 0x07E0, 0xFFE0
+};
+
+const uint8_t splashShapes_data[] PROGMEM = {
+  0x0F, 0xA1, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E,
+  0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x18, 0x2F, 0x4B,
+  0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13,
+  0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49,
+  0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23,
+  0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F,
+  0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F,
+  0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20,
+  0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03,
+  0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18,
+  0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F,
+  0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01,
+  0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20,
+  0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13,
+  0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49,
+  0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23,
+  0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F,
+  0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F,
+  0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20,
+  0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03,
+  0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18,
+  0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F,
+  0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01,
+  0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20,
+  0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13,
+  0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49,
+  0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23,
+  0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F,
+  0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F,
+  0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20,
+  0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03,
+  0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18,
+  0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F,
+  0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01,
+  0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20,
+  0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x18, 0x20, 0x1F, 0x49, 0x20, 0x1F, 0x03, 0x3F, 0x23, 0x13,
+  0x01, 0x18, 0x2F, 0x4B, 0x1F, 0x03, 0x3F, 0x23, 0x13, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01,
+  0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F,
+  0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E,
+  0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01,
+  0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F,
+  0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E,
+  0x01, 0x1F, 0x21, 0x4A, 0x1F, 0x3A, 0x5A, 0x1F, 0x0D, 0x01, 0x1F, 0x1D, 0x43, 0x1A, 0x43, 0x1F,
+  0x32, 0x5F, 0x03, 0x1F, 0x09, 0x01, 0x1F, 0x1B, 0x41, 0x1F, 0x03, 0x41, 0x1F, 0x2E, 0x5F, 0x07,
+  0x1F, 0x07, 0x01, 0x1F, 0x18, 0x42, 0x1F, 0x07, 0x42, 0x1F, 0x28, 0x5F, 0x0D, 0x1F, 0x04, 0x01,
+  0x1F, 0x17, 0x40, 0x1F, 0x0D, 0x40, 0x1F, 0x26, 0x5F, 0x0F, 0x1F, 0x03, 0x01, 0x1F, 0x15, 0x41,
+  0x1F, 0x0F, 0x41, 0x1F, 0x22, 0x5F, 0x13, 0x1F, 0x01, 0x01, 0x1F, 0x14, 0x40, 0x1F, 0x13, 0x40,
+  0x1F, 0x20, 0x5F, 0x15, 0x1F, 0x00, 0x01, 0x1F, 0x13, 0x40, 0x1F, 0x15, 0x40, 0x1F, 0x1E, 0x5F,
+  0x17, 0x1E, 0x01, 0x1F, 0x12, 0x40, 0x1F, 0x17, 0x40, 0x1F, 0x1C, 0x5F, 0x19, 0x1D, 0x01, 0x1F,
+  0x11, 0x40, 0x1F, 0x19, 0x40, 0x1F, 0x1A, 0x5F, 0x1B, 0x1C, 0x01, 0x1F, 0x10, 0x40, 0x1F, 0x1B,
+  0x40, 0x1F, 0x18, 0x5F, 0x1D, 0x1B, 0x01, 0x1F, 0x0F, 0x40, 0x1F, 0x1D, 0x40, 0x1F, 0x16, 0x5F,
+  0x1F, 0x1A, 0x01, 0x1F, 0x0E, 0x40, 0x1F, 0x1F, 0x40, 0x1F, 0x14, 0x5F, 0x21, 0x19, 0x01, 0x1F,
+  0x0D, 0x40, 0x1F, 0x21, 0x40, 0x1F, 0x12, 0x5F, 0x23, 0x18, 0x01, 0x1F, 0x0D, 0x40, 0x1F, 0x21,
+  0x40, 0x1F, 0x12, 0x5F, 0x23, 0x18, 0x01, 0x1F, 0x0C, 0x40, 0x1F, 0x23, 0x40, 0x1F, 0x10, 0x5F,
+  0x25, 0x17, 0x01, 0x1F, 0x0B, 0x40, 0x1F, 0x25, 0x40, 0x1F, 0x0E, 0x5F, 0x27, 0x16, 0x01, 0x1F,
+  0x0B, 0x40, 0x1F, 0x25, 0x40, 0x1F, 0x0E, 0x5F, 0x27, 0x16, 0x01, 0x1F, 0x0B, 0x40, 0x1F, 0x25,
+  0x40, 0x1F, 0x0E, 0x5F, 0x27, 0x16, 0x01, 0x1F, 0x0A, 0x40, 0x1F, 0x27, 0x40, 0x1F, 0x0C, 0x5F,
+  0x29, 0x15, 0x01, 0x1F, 0x0A, 0x40, 0x1F, 0x27, 0x40, 0x1F, 0x0C, 0x5F, 0x29, 0x15, 0x01, 0x1F,
+  0x09, 0x40, 0x1F, 0x29, 0x40, 0x1F, 0x0A, 0x5F, 0x2B, 0x14, 0x01, 0x1F, 0x09, 0x40, 0x1F, 0x29,
+  0x40, 0x1F, 0x0A, 0x5F, 0x2B, 0x14, 0x01, 0x1F, 0x09, 0x40, 0x1F, 0x29, 0x40, 0x1F, 0x0A, 0x5F,
+  0x2B, 0x14, 0x01, 0x1F, 0x09, 0x40, 0x1F, 0x29, 0x40, 0x1F, 0x0A, 0x5F, 0x2B, 0x14, 0x01, 0x1F,
+  0x08, 0x40, 0x1F, 0x2B, 0x40, 0x1F, 0x08, 0x5F, 0x2D, 0x13, 0x01, 0x1F, 0x08, 0x40, 0x1F, 0x2B,
+  0x40, 0x1F, 0x08, 0x5F, 0x2D, 0x13, 0x01, 0x1F, 0x08, 0x40, 0x1F, 0x2B, 0x40, 0x1F, 0x08, 0x5F,
+  0x2D, 0x13, 0x01, 0x1F, 0x08, 0x40, 0x1F, 0x2B, 0x40, 0x1F, 0x08, 0x5F, 0x2D, 0x13, 0x01, 0x1F,
+  0x08, 0x40, 0x1F, 0x2B, 0x40, 0x1F, 0x08, 0x5F, 0x2D, 0x13, 0x01, 0x1F, 0x08, 0x40, 0x1F, 0x2B,
+  0x40, 0x1F, 0x08, 0x5F, 0x2D, 0x13, 0x01, 0x1F, 0x08, 0x40, 0x1F, 0x2B, 0x40, 0x1F, 0x08, 0x5F,
+  0x2D, 0x13, 0x01, 0x1F, 0x08, 0x40, 0x1F, 0x2B, 0x40, 0x1F, 0x08, 0x5F, 0x2D, 0x13, 0x01, 0x1F,
+  0x08, 0x40, 0x1F, 0x2B, 0x40, 0x1F, 0x08, 0x5F, 0x2D, 0x13, 0x01, 0x1F, 0x08, 0x40, 0x1F, 0x2B,
+  0x40, 0x1F, 0x08, 0x5F, 0x2D, 0x13, 0x01, 0x1F, 0x08, 0x40, 0x1F, 0x2B, 0x40, 0x1F, 0x08, 0x5F,
+  0x2D, 0x13, 0x01, 0x1F, 0x09, 0x40, 0x1F, 0x29, 0x40, 0x1F, 0x0A, 0x5F, 0x2B, 0x14, 0x01, 0x1F,
+  0x09, 0x40, 0x1F, 0x29, 0x40, 0x1F, 0x0A, 0x5F, 0x2B, 0x14, 0x01, 0x1F, 0x09, 0x40, 0x1F, 0x29,
+  0x40, 0x1F, 0x0A, 0x5F, 0x2B, 0x14, 0x01, 0x1F, 0x09, 0x40, 0x1F, 0x29, 0x40, 0x1F, 0x0A, 0x5F,
+  0x2B, 0x14, 0x01, 0x1F, 0x0A, 0x40, 0x1F, 0x27, 0x40, 0x1F, 0x0C, 0x5F, 0x29, 0x15, 0x01, 0x1F,
+  0x0A, 0x40, 0x1F, 0x27, 0x40, 0x1F, 0x0C, 0x5F, 0x29, 0x15, 0x01, 0x1F, 0x0B, 0x40, 0x1F, 0x25,
+  0x40, 0x1F, 0x0E, 0x5F, 0x27, 0x16, 0x01, 0x1F, 0x0B, 0x40, 0x1F, 0x25, 0x40, 0x1F, 0x0E, 0x5F,
+  0x27, 0x16, 0x01, 0x1F, 0x0B, 0x40, 0x1F, 0x25, 0x40, 0x1F, 0x0E, 0x5F, 0x27, 0x16, 0x01, 0x1F,
+  0x0C, 0x40, 0x1F, 0x23, 0x40, 0x1F, 0x10, 0x5F, 0x25, 0x17, 0x01, 0x1F, 0x0D, 0x40, 0x1F, 0x21,
+  0x40, 0x1F, 0x12, 0x5F, 0x23, 0x18, 0x01, 0x1F, 0x0D, 0x40, 0x1F, 0x21, 0x40, 0x1F, 0x12, 0x5F,
+  0x23, 0x18, 0x01, 0x1F, 0x0E, 0x40, 0x1F, 0x1F, 0x40, 0x1F, 0x14, 0x5F, 0x21, 0x19, 0x01, 0x1F,
+  0x0F, 0x40, 0x1F, 0x1D, 0x40, 0x1F, 0x16, 0x5F, 0x1F, 0x1A, 0x01, 0x1F, 0x10, 0x40, 0x1F, 0x1B,
+  0x40, 0x1F, 0x18, 0x5F, 0x1D, 0x1B, 0x01, 0x1F, 0x11, 0x40, 0x1F, 0x19, 0x40, 0x1F, 0x1A, 0x5F,
+  0x1B, 0x1C, 0x01, 0x1F, 0x12, 0x40, 0x1F, 0x17, 0x40, 0x1F, 0x1C, 0x5F, 0x19, 0x1D, 0x01, 0x1F,
+  0x13, 0x40, 0x1F, 0x15, 0x40, 0x1F, 0x1E, 0x5F, 0x17, 0x1E, 0x01, 0x1F, 0x14, 0x40, 0x1F, 0x13,
+  0x40, 0x1F, 0x20, 0x5F, 0x15, 0x1F, 0x00, 0x01, 0x1F, 0x15, 0x41, 0x1F, 0x0F, 0x41, 0x1F, 0x22,
+  0x5F, 0x13, 0x1F, 0x01, 0x01, 0x1F, 0x17, 0x40, 0x1F, 0x0D, 0x40, 0x1F, 0x26, 0x5F, 0x0F, 0x1F,
+  0x03, 0x01, 0x1F, 0x18, 0x42, 0x1F, 0x07, 0x42, 0x1F, 0x28, 0x5F, 0x0D, 0x1F, 0x04, 0x01, 0x1F,
+  0x1B, 0x41, 0x1F, 0x03, 0x41, 0x1F, 0x2E, 0x5F, 0x07, 0x1F, 0x07, 0x01, 0x1F, 0x1D, 0x43, 0x1A,
+  0x43, 0x1F, 0x32, 0x5F, 0x03, 0x1F, 0x09, 0x01, 0x1F, 0x21, 0x4A, 0x1F, 0x3A, 0x5A, 0x1F, 0x0D,
+  0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01,
+  0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x18, 0x5F, 0x91, 0x13,
+  0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01,
+  0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F,
+  0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E,
+  0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01,
+  0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F,
+  0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E,
+  0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01,
+  0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F,
+  0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E,
+  0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01,
+  0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x01, 0x1F, 0x9E, 0x0F, 0xA1,
+};
+
+const RleAsset splashShapes = { 176, 220, 6, splashShapes_palette, splashShapes_data, 1616 };
+
+#endif
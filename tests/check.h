@@ -0,0 +1,45 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdio.h>
+
+// Minimal assertions for the host tests. A failed check is reported and
+// counted, and the test carries on so one run shows every failure.
+static int checkFailures = 0;
+
+#define CHECK(condition) checkResult((condition), #condition, __FILE__, __LINE__)
+#define CHECK_EQUAL(actual, expected) \
+  checkEqual((unsigned long)(actual), (unsigned long)(expected), #actual, __FILE__, __LINE__)
+
+static inline bool checkResult(bool passed, const char* text, const char* file, int line) {
+  if (!passed) {
+    checkFailures++;
+    if (checkFailures <= 20) {
+      fprintf(stderr, "%s:%d: check failed: %s\n", file, line, text);
+    }
+  }
+  return passed;
+}
+
+static inline bool checkEqual(unsigned long actual, unsigned long expected, const char* text,
+                              const char* file, int line) {
+  if (actual != expected) {
+    checkFailures++;
+    if (checkFailures <= 20) {
+      fprintf(stderr, "%s:%d: %s is %lu, expected %lu\n", file, line, text, actual, expected);
+    }
+  }
+  return actual == expected;
+}
+
+// Exit status for main()
+static inline int checkSummary(const char* name) {
+  if (checkFailures > 0) {
+    fprintf(stderr, "%s: %d check(s) failed\n", name, checkFailures);
+    return 1;
+  }
+  printf("%s: ok\n", name);
+  return 0;
+}
+
+#endif
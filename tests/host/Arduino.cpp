@@ -0,0 +1,84 @@
+#include "Arduino.h"
+#include "EEPROM.h"
+
+unsigned long hostMicros = 0;
+void (*hostDelayHook)() = NULL;
+HardwareSerial Serial;
+EEPROMClass EEPROM;
+
+static uint8_t pinLevels[32];
+
+unsigned long millis() {
+  return hostMicros / 1000;
+}
+
+unsigned long micros() {
+  return hostMicros;
+}
+
+void delay(unsigned long ms) {
+  hostMicros += ms * 1000;
+  if (hostDelayHook != NULL) {
+    hostDelayHook();
+  }
+}
+
+void delayMicroseconds(unsigned int us) {
+  hostMicros += us;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (mode == INPUT_PULLUP) {
+    digitalWrite(pin, HIGH);
+  }
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < sizeof(pinLevels) ? pinLevels[pin] : LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin < sizeof(pinLevels)) {
+    pinLevels[pin] = value;
+  }
+}
+
+int analogRead(uint8_t) {
+  return 0;
+}
+
+long random(long howBig) {
+  return howBig <= 0 ? 0 : rand() % howBig;
+}
+
+long random(long howSmall, long howBig) {
+  return howSmall >= howBig ? howSmall : howSmall + random(howBig - howSmall);
+}
+
+void randomSeed(unsigned long seed) {
+  srand(seed);
+}
+
+size_t HardwareSerial::write(uint8_t value) {
+  return fputc(value, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* data, size_t length) {
+  return fwrite(data, 1, length, stdout);
+}
+
+size_t HardwareSerial::print(const char* text) {
+  return fputs(text, stdout) == EOF ? 0 : strlen(text);
+}
+
+size_t HardwareSerial::print(char value) {
+  return write((uint8_t)value);
+}
+
+size_t HardwareSerial::print(long value, int base) {
+  return printf(base == HEX ? "%lX" : "%ld", value);
+}
+
+size_t HardwareSerial::print(unsigned long value, int base) {
+  return printf(base == HEX ? "%lX" : "%lu", value);
+}
@@ -0,0 +1,90 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Just enough of the Arduino core to build the game's modules on a PC for
+// the host tests. Time is simulated: it only moves when a test (or delay())
+// moves it.
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define DEC 10
+#define HEX 16
+
+#define PROGMEM
+#define PGM_P const char*
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#define pgm_read_word(address) (*(const uint16_t*)(address))
+#define pgm_read_ptr(address) (*(void* const*)(address))
+
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#define constrain(value, low, high) ((value) < (low) ? (low) : ((value) > (high) ? (high) : (value)))
+#define bit(b) (1UL << (b))
+#define _BV(b) (1 << (b))
+
+#define noInterrupts()
+#define interrupts()
+
+// Flash strings are plain strings on the host
+class __FlashStringHelper;
+#define F(string) (reinterpret_cast<const __FlashStringHelper*>(string))
+
+extern unsigned long hostMicros;   // Simulated clock
+// Called after every delay(), so a test can act while the code under test
+// waits. NULL for none.
+extern void (*hostDelayHook)();
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+int analogRead(uint8_t pin);
+
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+// Serial writes to stdout
+class HardwareSerial {
+ public:
+  void begin(unsigned long) {}
+  int availableForWrite() { return 64; }
+  size_t write(uint8_t value);
+  size_t write(const uint8_t* data, size_t length);
+
+  size_t print(const __FlashStringHelper* text) { return print(reinterpret_cast<const char*>(text)); }
+  size_t print(const char* text);
+  size_t print(char value);
+  size_t print(unsigned char value, int base = DEC) { return print((unsigned long)value, base); }
+  size_t print(int value, int base = DEC) { return print((long)value, base); }
+  size_t print(unsigned int value, int base = DEC) { return print((unsigned long)value, base); }
+  size_t print(long value, int base = DEC);
+  size_t print(unsigned long value, int base = DEC);
+
+  template <class T>
+  size_t println(T value) {
+    size_t written = print(value);
+    return written + println();
+  }
+  size_t println() { return print('\n'); }
+};
+
+extern HardwareSerial Serial;
+
+#endif
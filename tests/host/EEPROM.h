@@ -0,0 +1,33 @@
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include "Arduino.h"
+
+// 1 KB EEPROM (an Uno's) held in RAM. Tests can look at or damage the
+// cells directly and count writes.
+#define HOST_EEPROM_SIZE 1024
+
+class EEPROMClass {
+ public:
+  EEPROMClass() { erase(); }
+
+  uint8_t read(int address) { return cells[address]; }
+  void write(int address, uint8_t value) {
+    cells[address] = value;
+    writes++;
+  }
+  uint16_t length() { return HOST_EEPROM_SIZE; }
+
+  // A fresh EEPROM reads back as all 0xFF
+  void erase() {
+    memset(cells, 0xFF, sizeof(cells));
+    writes = 0;
+  }
+
+  uint8_t cells[HOST_EEPROM_SIZE];
+  unsigned long writes;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,83 @@
+#include "TFT_22_ILI9225.h"
+
+uint8_t Terminal6x8[] = {6, 8};
+uint8_t Terminal11x16[] = {11, 16};
+uint8_t Terminal12x16[] = {12, 16};
+
+uint16_t hostPanel[ILI9225_LCD_HEIGHT][ILI9225_LCD_WIDTH];
+
+void TFT_22_ILI9225::clear() {
+  fillRectangle(0, 0, ILI9225_LCD_WIDTH - 1, ILI9225_LCD_HEIGHT - 1, COLOR_BLACK);
+}
+
+// Off-panel pixels are dropped, as the panel's window would
+void TFT_22_ILI9225::drawPixel(uint16_t x, uint16_t y, uint16_t color) {
+  if (x < ILI9225_LCD_WIDTH && y < ILI9225_LCD_HEIGHT) {
+    hostPanel[y][x] = color;
+  }
+}
+
+void TFT_22_ILI9225::fillRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color) {
+  for (uint16_t y = min(y1, y2); y <= max(y1, y2); y++) {
+    for (uint16_t x = min(x1, x2); x <= max(x1, x2); x++) {
+      drawPixel(x, y, color);
+    }
+  }
+}
+
+void TFT_22_ILI9225::drawRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color) {
+  fillRectangle(x1, y1, x2, y1, color);
+  fillRectangle(x1, y2, x2, y2, color);
+  fillRectangle(x1, y1, x1, y2, color);
+  fillRectangle(x2, y1, x2, y2, color);
+}
+
+void TFT_22_ILI9225::drawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color) {
+  int steps = max(abs((int)x2 - (int)x1), abs((int)y2 - (int)y1));
+  for (int i = 0; i <= steps; i++) {
+    int x = steps == 0 ? x1 : x1 + ((int)x2 - (int)x1) * i / steps;
+    int y = steps == 0 ? y1 : y1 + ((int)y2 - (int)y1) * i / steps;
+    drawPixel(x, y, color);
+  }
+}
+
+void TFT_22_ILI9225::fillCircle(uint8_t x0, uint8_t y0, uint8_t radius, uint16_t color) {
+  for (int dy = -radius; dy <= radius; dy++) {
+    for (int dx = -radius; dx <= radius; dx++) {
+      if (dx * dx + dy * dy <= radius * radius) {
+        drawPixel(x0 + dx, y0 + dy, color);
+      }
+    }
+  }
+}
+
+void TFT_22_ILI9225::drawCircle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t color) {
+  int r = radius;
+  for (int dy = -r; dy <= r; dy++) {
+    for (int dx = -r; dx <= r; dx++) {
+      int d = dx * dx + dy * dy;
+      if (d <= r * r && d > (r - 1) * (r - 1)) {
+        drawPixel(x0 + dx, y0 + dy, color);
+      }
+    }
+  }
+}
+
+void TFT_22_ILI9225::setFont(uint8_t* font, bool) {
+  this->font = font;
+}
+
+uint16_t TFT_22_ILI9225::drawText(uint16_t x, uint16_t y, STRING s, uint16_t color) {
+  uint8_t width = font[0];
+  uint8_t height = font[1];
+  for (; *s; s++) {
+    for (uint8_t row = 0; row < height; row++) {
+      for (uint8_t column = 0; column <= width; column++) {
+        bool set = column < width && ((uint8_t)*s * 7 + column * 3 + row) % 5 == 0;
+        drawPixel(x + column, y + row, set ? color : background);
+      }
+    }
+    x += width + 1;
+  }
+  return x;
+}
@@ -0,0 +1,60 @@
+#ifndef HOST_TFT_22_ILI9225_H
+#define HOST_TFT_22_ILI9225_H
+
+#include "Arduino.h"
+
+// The panel as a framebuffer, with the library's drawing calls. Glyphs are
+// a fixed pattern per character rather than the real font, drawn with the
+// library's layout: each character cell plus one column of spacing, the
+// pixels that aren't set in the background colour.
+#define COLOR_BLACK 0x0000
+#define COLOR_WHITE 0xFFFF
+#define COLOR_RED 0xF800
+#define COLOR_GREEN 0x07E0
+#define COLOR_BLUE 0x001F
+#define COLOR_YELLOW 0xFFE0
+#define COLOR_DARKCYAN 0x03EF
+#define COLOR_MAGENTA 0xF81F
+
+#define ILI9225_LCD_WIDTH 176
+#define ILI9225_LCD_HEIGHT 220
+
+#define STRING const char*
+
+// Only the width and height at the start of each font are used
+extern uint8_t Terminal6x8[];
+extern uint8_t Terminal11x16[];
+extern uint8_t Terminal12x16[];
+
+extern uint16_t hostPanel[ILI9225_LCD_HEIGHT][ILI9225_LCD_WIDTH];
+
+class TFT_22_ILI9225 {
+ public:
+  TFT_22_ILI9225(int8_t, int8_t, int8_t, int8_t, int8_t, int8_t) {}
+  TFT_22_ILI9225(int8_t, int8_t, int8_t, int8_t) {}
+
+  void begin() {}
+  void setBacklight(bool) {}
+  void setBackgroundColor(uint16_t color = COLOR_BLACK) { background = color; }
+  void setOrientation(uint8_t orientation) { this->orientation = orientation % 4; }
+  uint8_t getOrientation() { return orientation; }
+  uint16_t maxX() { return ILI9225_LCD_WIDTH; }
+  uint16_t maxY() { return ILI9225_LCD_HEIGHT; }
+
+  void clear();
+  void drawPixel(uint16_t x, uint16_t y, uint16_t color);
+  void fillRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
+  void drawRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
+  void drawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
+  void fillCircle(uint8_t x0, uint8_t y0, uint8_t radius, uint16_t color);
+  void drawCircle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t color);
+  void setFont(uint8_t* font, bool monoSp = false);
+  uint16_t drawText(uint16_t x, uint16_t y, STRING s, uint16_t color = COLOR_WHITE);
+
+ private:
+  uint8_t orientation = 0;
+  uint16_t background = COLOR_BLACK;
+  uint8_t* font = Terminal6x8;
+};
+
+#endif
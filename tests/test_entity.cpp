@@ -0,0 +1,112 @@
+// Entity ids stay put while indexes move, and the collision pass catches
+// a fast ball that jumps over a pickup between two frames.
+#include "entity.h"
+#include "collision.h"
+#include "check.h"
+
+static int draws = 0;
+static int erases = 0;
+
+static void countDraw(uint8_t, uint8_t, uint8_t, uint16_t color) {
+  if (color == 0) {
+    erases++;
+  } else {
+    draws++;
+  }
+}
+
+static const EntityDrawFn drawTable[ENTITY_TYPE_COUNT] = {countDraw, countDraw, countDraw};
+
+static int hits[2];
+static int8_t lastAmount;
+
+static void onHit(uint8_t ball, uint8_t, uint8_t, int8_t amount) {
+  hits[ball]++;
+  lastAmount = amount;
+}
+
+static int indexOfId(uint8_t id) {
+  for (uint8_t i = 0; i < entities.count; i++) {
+    if (entities.id[i] == id) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static void testIdsSurviveRemoval() {
+  entityBegin(drawTable, 0);
+  draws = erases = 0;
+  entitySpawn(ENTITY_COIN, 10, 50, 4, 1, 1000, ACTION_SCORE, 1);
+  entitySpawn(ENTITY_COIN, 20, 50, 4, 1, 3000, ACTION_SCORE, 1);
+  entitySpawn(ENTITY_COIN, 30, 50, 4, 1, 2000, ACTION_SCORE, 1);
+  CHECK_EQUAL(draws, 3);
+
+  // The first coin expires; the last one moves into its index, keeping
+  // its id
+  entityUpdate(1000);
+  CHECK_EQUAL(entities.count, 2);
+  CHECK_EQUAL(erases, 1);
+  CHECK_EQUAL(indexOfId(0), -1);
+  CHECK_EQUAL(entities.x[indexOfId(1)], 20);
+  CHECK_EQUAL(entities.x[indexOfId(2)], 30);
+
+  // The freed id is the next one handed out
+  entitySpawn(ENTITY_HAZARD, 40, 50, 5, 1, 1000, ACTION_SCORE, -2);
+  CHECK_EQUAL(entities.x[indexOfId(0)], 40);
+  int index = entitySpawn(ENTITY_COIN, 0, 0, 4, 1, 1000, ACTION_SCORE, 1);
+  CHECK_EQUAL(entities.id[index], 3);
+}
+
+// With at most n live entities and removal before each spawn, ids stay
+// below n (the spectator stream's slots rely on it)
+static void testIdsStayBelowLiveCount() {
+  entityBegin(NULL, 0);
+  randomSeed(37);
+  uint8_t maxId = 0;
+  for (int i = 0; i < 1000; i++) {
+    if (entities.count == 3) {
+      entityRemove(random(0, 3));
+    }
+    entitySpawn(ENTITY_COIN, 10, 10, 4, 1, 1000, ACTION_SCORE, 1);
+    for (uint8_t e = 0; e < entities.count; e++) {
+      maxId = max(maxId, entities.id[e]);
+    }
+  }
+  CHECK_EQUAL(maxId, 2);
+}
+
+static void testFastBallCollects() {
+  entityBegin(drawTable, 0);
+  hits[0] = hits[1] = 0;
+  entitySpawn(ENTITY_POWERUP, 88, 100, 4, 1, 1000, ACTION_SCORE, 3);
+  entitySpawn(ENTITY_COIN, 20, 180, 4, 1, 1000, ACTION_SCORE, 1);
+
+  // Ball 1 goes from one side of the power-up to the other in one frame;
+  // ball 2 stays away from everything
+  EntityBall balls[2] = {{40, 100, 140, 100, 10}, {150, 30, 160, 30, 10}};
+  entityCollide(balls, 2, onHit);
+  CHECK_EQUAL(hits[0], 1);
+  CHECK_EQUAL(hits[1], 0);
+  CHECK_EQUAL(lastAmount, 3);
+  CHECK_EQUAL(entities.count, 1);
+  CHECK_EQUAL(entities.x[0], 20);
+}
+
+static void testSweptCircleHit() {
+  CHECK(sweptCircleHit(0, 0, 0, 0, 5, 0, 6));
+  CHECK(!sweptCircleHit(0, 0, 0, 0, 6, 0, 6));      // Touching isn't a hit
+  CHECK(sweptCircleHit(0, 0, 100, 0, 50, 13, 14));   // Passes beside it
+  CHECK(!sweptCircleHit(0, 0, 100, 0, 50, 14, 14));
+  CHECK(!sweptCircleHit(0, 0, 100, 0, 120, 0, 14));  // Stops short
+  CHECK(sweptCircleHit(0, 0, 100, 0, 110, 0, 14));
+  CHECK(!sweptCircleHit(0, 0, 100, 100, -20, -20, 14));  // Behind the start
+}
+
+int main() {
+  testIdsSurviveRemoval();
+  testIdsStayBelowLiveCount();
+  testFastBallCollects();
+  testSweptCircleHit();
+  return checkSummary("entity");
+}
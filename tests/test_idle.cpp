@@ -0,0 +1,123 @@
+// Idle waits on the simulated clock: what wakes them, how the idle time is
+// counted, and the edge-to-redraw latency.
+#include "idle.h"
+#include "check.h"
+
+#define PIN_A 4
+#define PIN_B 5
+
+static const uint8_t pins[] = {PIN_A, PIN_B};
+
+// Something a player does while a wait is in progress, after the given
+// number of 1 ms sleeps
+static int sleepsUntilInput = -1;
+static bool inputIsPin = false;
+
+static void onDelay() {
+  if (sleepsUntilInput > 0 && --sleepsUntilInput == 0) {
+    if (inputIsPin) {
+      digitalWrite(PIN_B, !digitalRead(PIN_B));
+    } else {
+      idleInjectEdge();
+    }
+  }
+}
+
+static void startIdle(unsigned long startMicros) {
+  hostMicros = startMicros;
+  hostDelayHook = onDelay;
+  sleepsUntilInput = -1;
+  idleBegin(pins, sizeof(pins));
+}
+
+static void inputAfter(int sleeps, bool pin) {
+  sleepsUntilInput = sleeps;
+  inputIsPin = pin;
+}
+
+static void testTimeout() {
+  startIdle(1000000);
+  CHECK(!idleWait(20));
+  CHECK_EQUAL(millis(), 1020);
+  CHECK_EQUAL(idleStats.deadlineWakes, 1);
+  CHECK_EQUAL(idleStats.tickWakes, 20);
+  CHECK_EQUAL(idleStats.inputWakes, 0);
+  CHECK_EQUAL(idleStats.idleMillis, 20);
+}
+
+// An edge that came in while the caller was busy returns at once, and only
+// once
+static void testEdgeBeforeWait() {
+  startIdle(1000000);
+  idleInjectEdge();
+  CHECK(idleWait(20));
+  CHECK_EQUAL(millis(), 1000);
+  CHECK_EQUAL(idleStats.inputWakes, 1);
+  CHECK(!idleWait(5));
+  CHECK_EQUAL(idleStats.deadlineWakes, 1);
+}
+
+// Edges during the wait, from the interrupt or from a polled pin, cut it
+// short; IDLE_FOREVER has no deadline
+static void testEdgeDuringWait() {
+  startIdle(1000000);
+  inputAfter(7, false);
+  CHECK(idleWait(20));
+  CHECK_EQUAL(millis(), 1007);
+
+  inputAfter(300, true);
+  CHECK(idleWait(IDLE_FOREVER));
+  CHECK_EQUAL(millis(), 1307);
+  CHECK_EQUAL(idleStats.inputWakes, 2);
+  CHECK_EQUAL(idleStats.deadlineWakes, 0);
+  CHECK_EQUAL(idleStats.idleMillis, 307);
+}
+
+// The idle total is built from micros() differences, so the counter
+// wrapping during a wait changes nothing. unsigned long is 64 bits here,
+// so the clock starts just below 2^64 rather than 2^32.
+static void testMicrosWrap() {
+  startIdle(0UL - 2500);
+  inputAfter(10, false);
+  CHECK(idleWait(IDLE_FOREVER));
+  CHECK_EQUAL(micros(), 7500);
+  CHECK_EQUAL(idleStats.idleMillis, 10);
+}
+
+// Latency runs from the edge to idleMarkRedrawn(). An edge that woke a
+// wait but was never redrawn doesn't carry over to the next wait.
+static void testRedrawLatency() {
+  startIdle(1000000);
+  inputAfter(5, false);
+  CHECK(idleWait(IDLE_FOREVER));
+  delayMicroseconds(1500);
+  idleMarkRedrawn();
+  CHECK_EQUAL(idleStats.lastLatencyMicros, 1500);
+  CHECK_EQUAL(idleStats.latencyCount, 1);
+
+  // Nothing new to report
+  idleMarkRedrawn();
+  CHECK_EQUAL(idleStats.latencyCount, 1);
+
+  // Woken but not redrawn, then a second edge later on
+  inputAfter(5, false);
+  CHECK(idleWait(IDLE_FOREVER));
+  delay(40);
+  inputAfter(3, false);
+  CHECK(idleWait(IDLE_FOREVER));
+  delayMicroseconds(700);
+  idleMarkRedrawn();
+  CHECK_EQUAL(idleStats.lastLatencyMicros, 700);
+  CHECK_EQUAL(idleStats.maxLatencyMicros, 1500);
+  CHECK_EQUAL(idleStats.latencySumMicros, 2200);
+  CHECK_EQUAL(idleStats.latencyCount, 2);
+}
+
+int main() {
+  testTimeout();
+  testEdgeBeforeWait();
+  testEdgeDuringWait();
+  testMicrosWrap();
+  testRedrawLatency();
+  return checkSummary("idle");
+}
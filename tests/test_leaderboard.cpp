@@ -0,0 +1,135 @@
+// The RAM index kept up to date by leaderboardRecordMatch() must always
+// equal what leaderboardBegin() rebuilds from the EEPROM after a power
+// cycle, through log wrap-around and damaged records.
+#include "leaderboard.h"
+#include "EEPROM.h"
+#include "check.h"
+
+// Rebuild the index from EEPROM as a reboot would, compare it with the
+// running one, and carry on with the running one
+static bool matchesReboot() {
+  LeaderboardIndex running;
+  LeaderboardStats stats;
+  memcpy(&running, &leaderboard, sizeof(running));
+  memcpy(&stats, &leaderboardStats, sizeof(stats));
+
+  leaderboardBegin();
+  bool same = memcmp(&running, &leaderboard, sizeof(running)) == 0;
+
+  memcpy(&leaderboard, &running, sizeof(running));
+  memcpy(&leaderboardStats, &stats, sizeof(stats));
+  return same;
+}
+
+static void testEmptyLog() {
+  EEPROM.erase();
+  leaderboardBegin();
+  CHECK_EQUAL(leaderboard.recordCount, 0);
+  CHECK_EQUAL(leaderboard.headSlot, 0);
+  CHECK_EQUAL(leaderboardBestScore(), 0);
+}
+
+// A high score whose record is overwritten leaves the top list
+static void testEvictedHighScore() {
+  EEPROM.erase();
+  leaderboardBegin();
+  leaderboardRecordMatch(200, 0, 60);
+  CHECK_EQUAL(leaderboardBestScore(), 200);
+
+  for (int i = 0; i < LOG_SLOTS - 1; i++) {
+    leaderboardRecordMatch(10, 5, 60);
+  }
+  CHECK_EQUAL(leaderboardBestScore(), 200);
+
+  // Wraps onto the 200-0 match
+  leaderboardRecordMatch(12, 7, 60);
+  CHECK_EQUAL(leaderboardBestScore(), 12);
+  CHECK_EQUAL(leaderboard.recordCount, LOG_SLOTS);
+  CHECK_EQUAL(leaderboard.winsP1, LOG_SLOTS);
+  CHECK(matchesReboot());
+}
+
+// Random matches (with plenty of ties) for several turns of the log
+static void testWrapMatchesReboot() {
+  EEPROM.erase();
+  leaderboardBegin();
+  randomSeed(26);
+  int mismatches = 0;
+  for (int i = 0; i < 4 * LOG_SLOTS; i++) {
+    leaderboardRecordMatch(random(0, 40), random(0, 40), 60);
+    if (!matchesReboot()) {
+      mismatches++;
+    }
+  }
+  CHECK_EQUAL(mismatches, 0);
+  CHECK_EQUAL(leaderboard.recordCount, LOG_SLOTS);
+  CHECK_EQUAL(leaderboard.winsP1 + leaderboard.winsP2 + leaderboard.ties, LOG_SLOTS);
+}
+
+// A record with a bad CRC is skipped at boot and not counted when the log
+// wraps over it
+static void testCorruptRecord() {
+  EEPROM.erase();
+  leaderboardBegin();
+  for (int i = 0; i < LOG_SLOTS; i++) {
+    leaderboardRecordMatch(i == 5 ? 99 : 20, 10, 60);
+  }
+
+  // Flip a bit in the score of the 99 record
+  EEPROM.cells[LOG_BASE_ADDRESS + 5 * LOG_RECORD_SIZE + 3] ^= 0x04;
+  leaderboardBegin();
+  CHECK_EQUAL(leaderboardStats.corruptSlots, 1);
+  CHECK_EQUAL(leaderboard.recordCount, LOG_SLOTS - 1);
+  CHECK_EQUAL(leaderboard.winsP1, LOG_SLOTS - 1);
+  CHECK_EQUAL(leaderboardBestScore(), 20);
+  CHECK_EQUAL(leaderboard.headSlot, 0);
+
+  // Append over the damaged slot and past it
+  int mismatches = 0;
+  for (int i = 0; i < 10; i++) {
+    leaderboardRecordMatch(3, 30, 60);
+    if (!matchesReboot()) {
+      mismatches++;
+    }
+  }
+  CHECK_EQUAL(mismatches, 0);
+  CHECK_EQUAL(leaderboard.recordCount, LOG_SLOTS);
+  CHECK_EQUAL(leaderboard.winsP2, 10);
+  CHECK_EQUAL(leaderboardBestScore(), 30);
+}
+
+// A torn write that never got as far as the magic byte is an empty slot
+static void testTornRecord() {
+  EEPROM.erase();
+  leaderboardBegin();
+  for (int i = 0; i < 3; i++) {
+    leaderboardRecordMatch(4, 2, 60);
+  }
+  EEPROM.cells[LOG_BASE_ADDRESS + 2 * LOG_RECORD_SIZE] = 0xFF;
+  leaderboardBegin();
+  CHECK_EQUAL(leaderboard.recordCount, 2);
+  CHECK_EQUAL(leaderboard.headSlot, 2);
+  CHECK_EQUAL(leaderboard.nextSeq, 3);
+  CHECK_EQUAL(leaderboardStats.corruptSlots, 0);
+}
+
+// Identical matches only rewrite the bytes that change
+static void testWriteAmplification() {
+  EEPROM.erase();
+  leaderboardBegin();
+  for (int i = 0; i < 2 * LOG_SLOTS; i++) {
+    leaderboardRecordMatch(5, 5, 60);
+  }
+  CHECK(leaderboardStats.physicalBytes < leaderboardStats.logicalBytes);
+  CHECK_EQUAL(EEPROM.writes, leaderboardStats.physicalBytes);
+}
+
+int main() {
+  testEmptyLog();
+  testEvictedHighScore();
+  testWrapMatchesReboot();
+  testCorruptRecord();
+  testTornRecord();
+  testWriteAmplification();
+  return checkSummary("leaderboard");
+}
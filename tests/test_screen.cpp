@@ -0,0 +1,319 @@
+// Retained screens: after every transition the panel must look exactly as
+// if it had been cleared and the new screen drawn from scratch.
+#include "screen.h"
+#include "check.h"
+
+// The display bus is bypassed: fills go straight to the panel model
+static TFT_22_ILI9225 panel(0, 0, 0, 0);
+
+void lcdFillRectangle(int x0, int y0, int x1, int y1, uint16_t color) {
+  panel.fillRectangle(x0, y0, x1, y1, color);
+}
+
+void lcdFillCircle(int x0, int y0, int radius, uint16_t color) {
+  panel.fillCircle(x0, y0, radius, color);
+}
+
+void lcdInvalidate() {}
+
+static GameTFT tft(0, 0, 0, 0);
+
+// The game's screens, built either through the screen module or drawn
+// directly onto a cleared panel as the reference
+static bool direct;
+static uint8_t menuIndex1, menuIndex2;
+static int score1, score2;
+
+static void text(uint8_t x, uint8_t y, const char* s, uint16_t color, uint8_t* font) {
+  if (direct) {
+    panel.setFont(font);
+    panel.drawText(x, y, s, color);
+  } else {
+    screenText(x, y, s, color, font);
+  }
+}
+
+static void rectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint16_t color) {
+  if (direct) {
+    panel.drawRectangle(x1, y1, x2, y2, color);
+  } else {
+    screenRectangle(x1, y1, x2, y2, color);
+  }
+}
+
+static void line(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint16_t color) {
+  if (direct) {
+    panel.fillRectangle(x1, y1, min(x2, ILI9225_LCD_WIDTH - 1), y2, color);
+  } else {
+    screenLine(x1, y1, x2, y2, color);
+  }
+}
+
+static void area(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2) {
+  if (!direct) {
+    screenArea(x1, y1, x2, y2);
+  }
+}
+
+static void menuOptions() {
+  text(10, 80, " YES", COLOR_WHITE, Terminal12x16);
+  text(10, 120, " NO", COLOR_WHITE, Terminal12x16);
+  if (menuIndex1 == 0) {
+    rectangle(5, 76, 170, 97, COLOR_RED);
+  } else {
+    rectangle(5, 116, 170, 137, COLOR_RED);
+  }
+  if (menuIndex2 == 0) {
+    rectangle(2, 73, 173, 100, COLOR_BLUE);
+  } else {
+    rectangle(2, 113, 173, 140, COLOR_BLUE);
+  }
+}
+
+static void addScreen(uint8_t id) {
+  char buffer[20];
+  switch (id) {
+    case SCREEN_MENU:
+      text(5, 10, "Do you want to", COLOR_WHITE, Terminal12x16);
+      text(5, 35, "START the Game?", COLOR_WHITE, Terminal12x16);
+      menuOptions();
+      text(10, 164, "Player1 -> RED", COLOR_RED, Terminal11x16);
+      text(10, 190, "Player2 -> BLUE", COLOR_BLUE, Terminal11x16);
+      break;
+    case SCREEN_GAME_STARTS:
+      text(26, 100, "Game Starts", COLOR_WHITE, Terminal11x16);
+      break;
+    case SCREEN_GAME:
+      text(10, 5, "P1:", COLOR_RED, Terminal6x8);
+      text(64, 5, "TIME:", COLOR_WHITE, Terminal6x8);
+      text(136, 5, "P2:", COLOR_BLUE, Terminal6x8);
+      line(0, 20, ILI9225_LCD_WIDTH, 20, COLOR_WHITE);
+      line(0, 200, ILI9225_LCD_WIDTH, 200, COLOR_WHITE);
+      area(30, 5, 50, 15);
+      area(103, 5, 130, 15);
+      area(156, 5, 175, 15);
+      area(0, 21, ILI9225_LCD_WIDTH - 1, 199);
+      break;
+    case SCREEN_RESULTS:
+      // Scores from a temporary buffer, as showResults() does
+      text(40, 40, "GAME OVER", COLOR_WHITE, Terminal12x16);
+      sprintf(buffer, "P1: %d", score1);
+      text(40, 80, buffer, COLOR_RED, Terminal12x16);
+      sprintf(buffer, "P2: %d", score2);
+      text(40, 110, buffer, COLOR_BLUE, Terminal12x16);
+      text(40, 150, score1 > score2 ? "P1 WINS!" : "IT'S A TIE!", COLOR_WHITE, Terminal12x16);
+      break;
+    case SCREEN_PLAY_AGAIN:
+      text(5, 10, "Play Again?", COLOR_WHITE, Terminal12x16);
+      menuOptions();
+      break;
+    case SCREEN_THANK_YOU:
+      text(30, 100, "Thank You!", COLOR_WHITE, Terminal11x16);
+      break;
+  }
+}
+
+static uint16_t expected[ILI9225_LCD_HEIGHT][ILI9225_LCD_WIDTH];
+static uint16_t shown[ILI9225_LCD_HEIGHT][ILI9225_LCD_WIDTH];
+
+// Show a screen through the module, then compare it with the reference
+static bool showMatchesRedraw(uint8_t id) {
+  direct = false;
+  screenBegin(id);
+  addScreen(id);
+  screenEnd(tft);
+  memcpy(shown, hostPanel, sizeof(shown));
+
+  direct = true;
+  panel.clear();
+  addScreen(id);
+  memcpy(expected, hostPanel, sizeof(expected));
+
+  memcpy(hostPanel, shown, sizeof(hostPanel));
+  return memcmp(shown, expected, sizeof(shown)) == 0;
+}
+
+// What the game draws in the game screen's areas during a match
+static void playMatch() {
+  for (int i = 0; i < 20; i++) {
+    int x = random(0, ILI9225_LCD_WIDTH);
+    int y = random(31, 190);
+    panel.fillCircle(x, y, random(3, 12), random(1, 0x10000));
+  }
+  panel.fillRectangle(30, 5, 50, 15, random(1, 0x10000));
+  panel.fillRectangle(103, 5, 130, 15, random(1, 0x10000));
+}
+
+static void startFromBlankPanel() {
+  panel.clear();
+  screenBegin(SCREEN_THANK_YOU);
+  screenEnd(tft);
+}
+
+// A screen the game can show after last; the lists are sized for these
+// transitions only
+static uint8_t nextScreen(uint8_t last) {
+  static const uint8_t fromMenu[] = {SCREEN_MENU, SCREEN_GAME_STARTS, SCREEN_THANK_YOU};
+  static const uint8_t fromPlayAgain[] = {SCREEN_PLAY_AGAIN, SCREEN_GAME_STARTS, SCREEN_MENU};
+  switch (last) {
+    case SCREEN_MENU:
+      return fromMenu[random(0, 3)];
+    case SCREEN_GAME_STARTS:
+      return SCREEN_GAME;
+    case SCREEN_GAME:
+      return SCREEN_RESULTS;
+    case SCREEN_RESULTS:
+      return random(0, 2) ? SCREEN_PLAY_AGAIN : SCREEN_MENU;
+    case SCREEN_PLAY_AGAIN:
+      return fromPlayAgain[random(0, 3)];
+    default:
+      return SCREEN_MENU;
+  }
+}
+
+static void testRandomTransitions() {
+  startFromBlankPanel();
+  randomSeed(35);
+  int mismatches = 0;
+  uint8_t last = SCREEN_THANK_YOU;
+  for (int step = 0; step < 2000; step++) {
+    uint8_t id = nextScreen(last);
+    menuIndex1 = random(0, 2);
+    menuIndex2 = random(0, 2);
+    score1 = random(0, 3);
+    score2 = random(0, 3);
+    if (!showMatchesRedraw(id)) {
+      mismatches++;
+    }
+    if (id == SCREEN_GAME) {
+      playMatch();
+    }
+    last = id;
+  }
+  CHECK_EQUAL(mismatches, 0);
+  CHECK_EQUAL(screenStats.overflows, 0);
+}
+
+// Moving a selection only redraws around the highlight
+static void testMenuSelectionChange() {
+  startFromBlankPanel();
+  menuIndex1 = 0;
+  menuIndex2 = 0;
+  CHECK(showMatchesRedraw(SCREEN_MENU));
+  menuIndex1 = 1;
+  CHECK(showMatchesRedraw(SCREEN_MENU));
+  CHECK(screenStats.pixels[SCREEN_MENU] * 10 < screenStats.fullPixels[SCREEN_MENU]);
+}
+
+// Erasing or drawing one primitive over a kept one puts the kept one back
+static void testOverlapRedraw() {
+  startFromBlankPanel();
+  direct = false;
+  screenBegin(SCREEN_MENU);
+  screenText(10, 10, "ABCD", COLOR_WHITE, Terminal12x16);
+  screenText(30, 20, "kept", COLOR_RED, Terminal12x16);
+  screenRectangle(0, 60, 100, 90, COLOR_BLUE);
+  screenEnd(tft);
+
+  // The first text goes and is erased over the second; a new line is
+  // drawn across the kept rectangle and then the rectangle again
+  screenBegin(SCREEN_MENU);
+  screenLine(0, 60, 120, 60, COLOR_GREEN);
+  screenText(30, 20, "kept", COLOR_RED, Terminal12x16);
+  screenRectangle(0, 60, 100, 90, COLOR_BLUE);
+  screenEnd(tft);
+  memcpy(shown, hostPanel, sizeof(shown));
+
+  panel.clear();
+  panel.fillRectangle(0, 60, 120, 60, COLOR_GREEN);
+  panel.setFont(Terminal12x16);
+  panel.drawText(30, 20, "kept", COLOR_RED);
+  panel.drawRectangle(0, 60, 100, 90, COLOR_BLUE);
+  CHECK(memcmp(shown, hostPanel, sizeof(shown)) == 0);
+  memcpy(hostPanel, shown, sizeof(hostPanel));
+}
+
+// The caller's string can change or go away once screenText() returns
+static void testTextIsCopied() {
+  startFromBlankPanel();
+  char buffer[20];
+  strcpy(buffer, "P1: 7");
+  screenBegin(SCREEN_RESULTS);
+  screenText(40, 80, buffer, COLOR_RED, Terminal12x16);
+  strcpy(buffer, "garbage!");
+  screenEnd(tft);
+  memcpy(shown, hostPanel, sizeof(shown));
+
+  panel.clear();
+  panel.setFont(Terminal12x16);
+  panel.drawText(40, 80, "P1: 7", COLOR_RED);
+  CHECK(memcmp(shown, hostPanel, sizeof(shown)) == 0);
+
+  // The old text is replaced by one it overlaps; the new one is drawn
+  // from its own copy too
+  memcpy(hostPanel, shown, sizeof(hostPanel));
+  score1 = 2;
+  score2 = 1;
+  CHECK(showMatchesRedraw(SCREEN_RESULTS));
+}
+
+// Texts of the same length in the same place are told apart by content;
+// "Aa" and "BB" had the same 16-bit hash
+static void testSameBoxNewText() {
+  startFromBlankPanel();
+  screenBegin(SCREEN_RESULTS);
+  screenText(40, 80, "Aa", COLOR_RED, Terminal12x16);
+  screenEnd(tft);
+  screenBegin(SCREEN_RESULTS);
+  screenText(40, 80, "BB", COLOR_RED, Terminal12x16);
+  screenEnd(tft);
+  memcpy(shown, hostPanel, sizeof(shown));
+
+  panel.clear();
+  panel.setFont(Terminal12x16);
+  panel.drawText(40, 80, "BB", COLOR_RED);
+  CHECK(memcmp(shown, hostPanel, sizeof(shown)) == 0);
+  memcpy(hostPanel, shown, sizeof(hostPanel));
+}
+
+// Text that doesn't fit the pool is dropped and counted; what fits is
+// drawn and erased as usual
+static void testPoolOverflow() {
+  startFromBlankPanel();
+  unsigned long overflows = screenStats.overflows;
+  char row[16];
+  memset(row, 'x', sizeof(row) - 1);
+  row[sizeof(row) - 1] = '\0';
+  uint8_t fits = SCREEN_TEXT_POOL / sizeof(row);
+  screenBegin(SCREEN_MENU);
+  for (uint8_t i = 0; i <= fits; i++) {
+    screenText(0, 10 * i, row, COLOR_WHITE, Terminal6x8);
+  }
+  screenEnd(tft);
+  CHECK_EQUAL(screenStats.overflows, overflows + 1);
+  memcpy(shown, hostPanel, sizeof(shown));
+
+  panel.clear();
+  panel.setFont(Terminal6x8);
+  for (uint8_t i = 0; i < fits; i++) {
+    panel.drawText(0, 10 * i, row, COLOR_WHITE);
+  }
+  CHECK(memcmp(shown, hostPanel, sizeof(shown)) == 0);
+
+  memcpy(hostPanel, shown, sizeof(hostPanel));
+  screenBegin(SCREEN_THANK_YOU);
+  screenEnd(tft);
+  memcpy(shown, hostPanel, sizeof(shown));
+  panel.clear();
+  CHECK(memcmp(shown, hostPanel, sizeof(shown)) == 0);
+}
+
+int main() {
+  testRandomTransitions();
+  testMenuSelectionChange();
+  testOverlapRedraw();
+  testTextIsCopied();
+  testSameBoxNewText();
+  testPoolOverflow();
+  return checkSummary("screen");
+}
@@ -0,0 +1,168 @@
+// Timer wheel firing times and timerWheelNextDeadline() against a plain
+// list of expected expiries.
+#include "timerwheel.h"
+#include "check.h"
+
+#define MODEL_TIMERS 64
+
+// What the wheel should be doing, timer by timer
+struct ModelTimer {
+  bool live;
+  uint8_t id;
+  unsigned long due;      // Expected expiry in ms
+  unsigned long period;   // ms, 0 for one-shot
+  int fired;
+};
+
+static ModelTimer model[MODEL_TIMERS];
+static unsigned long now;
+static unsigned long wheelStart;
+static unsigned long lastAdvance;
+static int lateFires = 0;
+
+static void onModelTimer(uint8_t index) {
+  ModelTimer& t = model[index];
+  long late = (long)(now - t.due);
+  if (!t.live || late < 0 || late >= TIMER_TICK_MS) {
+    lateFires++;
+  }
+  t.fired++;
+  if (t.period != 0) {
+    t.due += t.period;
+  } else {
+    t.live = false;
+  }
+}
+
+static void resetModel(unsigned long start) {
+  memset(model, 0, sizeof(model));
+  timerWheelReset(start);
+  now = start;
+  wheelStart = start;
+  lastAdvance = start;
+}
+
+static unsigned long roundUpToTicks(unsigned long ms) {
+  unsigned long ticks = (ms + TIMER_TICK_MS - 1) / TIMER_TICK_MS;
+  return (ticks == 0 ? 1 : ticks) * TIMER_TICK_MS;
+}
+
+static bool startModelTimer(uint8_t index, unsigned long delayMs, unsigned long periodMs) {
+  uint8_t id = timerStart(delayMs, periodMs, onModelTimer, index);
+  if (id == TIMER_NONE) {
+    return false;
+  }
+  // The wheel counts from the last tick it processed
+  unsigned long tickTime = wheelStart + (lastAdvance - wheelStart) / TIMER_TICK_MS * TIMER_TICK_MS;
+  ModelTimer& t = model[index];
+  t.live = true;
+  t.id = id;
+  t.due = tickTime + roundUpToTicks(delayMs);
+  t.period = periodMs == 0 ? 0 : roundUpToTicks(periodMs);
+  t.fired = 0;
+  return true;
+}
+
+static void advanceTo(unsigned long time) {
+  now = time;
+  timerWheelAdvance(now);
+  lastAdvance = now;
+}
+
+static unsigned long modelDeadline() {
+  unsigned long deadline = TIMER_NO_DEADLINE;
+  for (int i = 0; i < MODEL_TIMERS; i++) {
+    if (model[i].live) {
+      long left = (long)(model[i].due - now);
+      unsigned long wait = left < 0 ? 0 : left;
+      deadline = min(deadline, wait);
+    }
+  }
+  return deadline;
+}
+
+// A timer parked beyond the wheel's range sits in the level 1 slot that
+// cascades next; a nearer timer further along level 1 must still win
+static void testParkedTimerDoesNotHideNearerOne() {
+  resetModel(0);
+  startModelTimer(0, 15000, 0);
+  advanceTo(9620);
+  startModelTimer(1, 1000, 0);
+  CHECK_EQUAL(timerWheelNextDeadline(now), 1000);
+  CHECK_EQUAL(modelDeadline(), 1000);
+
+  advanceTo(10620);
+  CHECK_EQUAL(model[1].fired, 1);
+  CHECK_EQUAL(timerWheelNextDeadline(now), 15000 - 10620);
+  advanceTo(15000);
+  CHECK_EQUAL(model[0].fired, 1);
+  CHECK_EQUAL(timerWheelNextDeadline(now), TIMER_NO_DEADLINE);
+}
+
+static void testCancel() {
+  resetModel(0);
+  startModelTimer(0, 50, 0);
+  startModelTimer(1, 500, 0);
+  timerCancel(model[0].id);
+  model[0].live = false;
+  CHECK_EQUAL(timerWheelNextDeadline(now), 500);
+  for (unsigned long time = 1; time <= 1000; time++) {
+    advanceTo(time);
+  }
+  CHECK_EQUAL(model[0].fired, 0);
+  CHECK_EQUAL(model[1].fired, 1);
+  CHECK_EQUAL(timerWheelActiveCount(), 0);
+}
+
+// Random starts, cancels and advances, with millis() wrapping part way
+static void testRandomAgainstModel() {
+  resetModel(0xFFFFFFFFUL - 200000);
+  randomSeed(29);
+  int deadlineErrors = 0;
+  int used = 0;
+
+  for (long step = 0; step < 200000; step++) {
+    now += random(0, 7);
+
+    if (random(0, 40) == 0) {
+      // Reuse the first finished model entry
+      int index = -1;
+      for (int i = 0; i < MODEL_TIMERS && index < 0; i++) {
+        if (!model[i].live) {
+          index = i;
+        }
+      }
+      if (index >= 0) {
+        unsigned long delayMs = random(0, 4) == 0 ? random(0, 40000) : random(0, 2000);
+        unsigned long periodMs = random(0, 3) == 0 ? random(1, 300) * TIMER_TICK_MS : 0;
+        if (startModelTimer(index, delayMs, periodMs)) {
+          used++;
+        }
+      }
+    }
+
+    if (random(0, 30) == 0) {
+      int index = random(0, MODEL_TIMERS);
+      if (model[index].live) {
+        timerCancel(model[index].id);
+        model[index].live = false;
+      }
+    }
+
+    if (timerWheelNextDeadline(now) != modelDeadline()) {
+      deadlineErrors++;
+    }
+    advanceTo(now);
+  }
+
+  CHECK(used > 1000);
+  CHECK_EQUAL(deadlineErrors, 0);
+  CHECK_EQUAL(lateFires, 0);
+}
+
+int main() {
+  testParkedTimerDoesNotHideNearerOne();
+  testCancel();
+  testRandomAgainstModel();
+  return checkSummary("timerwheel");
+}
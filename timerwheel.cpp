@@ -0,0 +1,210 @@
+#include "timerwheel.h"
+
+#define TIMER_LISTS (TIMER_L0_SLOTS + TIMER_L1_SLOTS)
+#define TIMER_L0_MASK (TIMER_L0_SLOTS - 1)
+#define TIMER_L1_MASK (TIMER_L1_SLOTS - 1)
+#define TIMER_RANGE ((unsigned long)TIMER_L0_SLOTS * TIMER_L1_SLOTS)
+
+struct Timer {
+  unsigned long expires;    // Absolute expiry in wheel ticks
+  unsigned long period;     // Re-arm interval in ticks, 0 for one-shot
+  TimerCallback callback;
+  uint8_t arg;
+  uint8_t list;             // Wheel slot the timer is linked into, TIMER_NONE if not linked
+  uint8_t prev;
+  uint8_t next;
+};
+
+static Timer timers[TIMER_POOL_SIZE];
+static uint8_t timerLists[TIMER_LISTS];   // Head of each wheel slot
+static uint8_t freeTimers = TIMER_NONE;    // Head of the free list (chained through next)
+static uint8_t activeTimers = 0;
+static unsigned long wheelStartTime = 0;   // millis() at tick 0
+static unsigned long wheelTicks = 0;       // Last tick that has been processed
+
+// Convert a delay in ms to ticks, rounding up and never less than one tick
+static unsigned long msToTicks(unsigned long ms) {
+  unsigned long ticks = (ms + TIMER_TICK_MS - 1) / TIMER_TICK_MS;
+  return ticks == 0 ? 1 : ticks;
+}
+
+// File a timer into the slot matching its expiry
+static void linkTimer(uint8_t id) {
+  Timer& t = timers[id];
+  unsigned long delta = t.expires - wheelTicks;
+  uint8_t list;
+
+  if (delta < TIMER_L0_SLOTS) {
+    list = t.expires & TIMER_L0_MASK;
+  } else {
+    // Beyond the wheel's range: park it in the furthest slot, it gets
+    // re-filed with its real expiry when that slot cascades
+    unsigned long expires = delta < TIMER_RANGE ? t.expires : wheelTicks + TIMER_RANGE - 1;
+    list = TIMER_L0_SLOTS + ((expires >> TIMER_L0_BITS) & TIMER_L1_MASK);
+  }
+
+  t.list = list;
+  t.prev = TIMER_NONE;
+  t.next = timerLists[list];
+  if (t.next != TIMER_NONE) {
+    timers[t.next].prev = id;
+  }
+  timerLists[list] = id;
+}
+
+// Remove a timer from whatever slot it is in
+static void unlinkTimer(uint8_t id) {
+  Timer& t = timers[id];
+  if (t.prev != TIMER_NONE) {
+    timers[t.prev].next = t.next;
+  } else {
+    timerLists[t.list] = t.next;
+  }
+  if (t.next != TIMER_NONE) {
+    timers[t.next].prev = t.prev;
+  }
+  t.list = TIMER_NONE;
+}
+
+static void freeTimer(uint8_t id) {
+  timers[id].callback = NULL;
+  timers[id].next = freeTimers;
+  freeTimers = id;
+  activeTimers--;
+}
+
+// Drop all timers and restart the wheel at the given time
+void timerWheelReset(unsigned long now) {
+  for (int i = 0; i < TIMER_LISTS; i++) {
+    timerLists[i] = TIMER_NONE;
+  }
+  freeTimers = TIMER_NONE;
+  for (int i = TIMER_POOL_SIZE - 1; i >= 0; i--) {
+    timers[i].list = TIMER_NONE;
+    timers[i].callback = NULL;
+    timers[i].next = freeTimers;
+    freeTimers = i;
+  }
+  activeTimers = 0;
+  wheelStartTime = now;
+  wheelTicks = 0;
+}
+
+// Start a timer that fires after delayMs, then every periodMs (0 = once).
+// Returns the timer id, or TIMER_NONE if the pool is exhausted.
+uint8_t timerStart(unsigned long delayMs, unsigned long periodMs, TimerCallback callback, uint8_t arg) {
+  if (freeTimers == TIMER_NONE) {
+    return TIMER_NONE;
+  }
+
+  uint8_t id = freeTimers;
+  freeTimers = timers[id].next;
+  activeTimers++;
+
+  Timer& t = timers[id];
+  t.expires = wheelTicks + msToTicks(delayMs);
+  t.period = periodMs == 0 ? 0 : msToTicks(periodMs);
+  t.callback = callback;
+  t.arg = arg;
+  linkTimer(id);
+  return id;
+}
+
+// Cancel a running timer
+void timerCancel(uint8_t id) {
+  if (id >= TIMER_POOL_SIZE || timers[id].callback == NULL) {
+    return;
+  }
+  if (timers[id].list != TIMER_NONE) {
+    unlinkTimer(id);
+  }
+  freeTimer(id);
+}
+
+// Process every tick up to the given time, firing expired timers
+void timerWheelAdvance(unsigned long now) {
+  unsigned long targetTicks = (now - wheelStartTime) / TIMER_TICK_MS;
+
+  while ((long)(targetTicks - wheelTicks) > 0) {
+    if (activeTimers == 0) {
+      // Nothing pending, skip the idle ticks
+      wheelTicks = targetTicks;
+      break;
+    }
+
+    wheelTicks++;
+
+    // Start of a new level 0 turn: pull the next level 1 slot down
+    if ((wheelTicks & TIMER_L0_MASK) == 0) {
+      uint8_t list = TIMER_L0_SLOTS + ((wheelTicks >> TIMER_L0_BITS) & TIMER_L1_MASK);
+      uint8_t id = timerLists[list];
+      timerLists[list] = TIMER_NONE;
+      while (id != TIMER_NONE) {
+        uint8_t next = timers[id].next;
+        linkTimer(id);
+        id = next;
+      }
+    }
+
+    // Fire everything in this tick's slot
+    uint8_t list = wheelTicks & TIMER_L0_MASK;
+    while (timerLists[list] != TIMER_NONE) {
+      uint8_t id = timerLists[list];
+      Timer& t = timers[id];
+      TimerCallback callback = t.callback;
+      uint8_t arg = t.arg;
+
+      unlinkTimer(id);
+      if (t.period != 0) {
+        t.expires += t.period;
+        linkTimer(id);
+      } else {
+        freeTimer(id);
+      }
+      callback(arg);
+    }
+  }
+}
+
+// Time in ms from now until the next timer fires, TIMER_NO_DEADLINE if none
+unsigned long timerWheelNextDeadline(unsigned long now) {
+  if (activeTimers == 0) {
+    return TIMER_NO_DEADLINE;
+  }
+
+  unsigned long deadlineTicks = TIMER_NO_DEADLINE;
+
+  // Level 0 slots hold exactly one tick each, the first busy one is the
+  // nearest expiry within this turn
+  for (unsigned long i = 1; i < TIMER_L0_SLOTS; i++) {
+    if (timerLists[(wheelTicks + i) & TIMER_L0_MASK] != TIMER_NONE) {
+      deadlineTicks = i;
+      break;
+    }
+  }
+
+  // Level 1 timers keep their exact expiry, but a slot can also hold timers
+  // parked far beyond the wheel's range, so every slot has to be looked at
+  for (uint8_t list = TIMER_L0_SLOTS; list < TIMER_LISTS; list++) {
+    for (uint8_t id = timerLists[list]; id != TIMER_NONE; id = timers[id].next) {
+      if (timers[id].expires - wheelTicks < deadlineTicks) {
+        deadlineTicks = timers[id].expires - wheelTicks;
+      }
+    }
+  }
+
+  if (deadlineTicks == TIMER_NO_DEADLINE) {
+    return TIMER_NO_DEADLINE;
+  }
+
+  // Convert to ms, accounting for time already elapsed since the last tick
+  unsigned long deadline = wheelStartTime + (wheelTicks + deadlineTicks) * TIMER_TICK_MS;
+  if ((long)(deadline - now) <= 0) {
+    return 0;
+  }
+  return deadline - now;
+}
+
+uint8_t timerWheelActiveCount() {
+  return activeTimers;
+}
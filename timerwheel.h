@@ -0,0 +1,31 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include "Arduino.h"
+
+// Two-level hashed timer wheel. Level 0 has one slot per tick, level 1 one
+// slot per full turn of level 0; timers further out than both levels are
+// parked in the last level 1 slot and re-filed when it cascades. Start and
+// cancel are O(1), advancing costs one slot per elapsed tick.
+#define TIMER_TICK_MS 10
+#define TIMER_L0_BITS 5
+#define TIMER_L0_SLOTS (1 << TIMER_L0_BITS)   // 32 ticks = 320 ms
+#define TIMER_L1_SLOTS 32                     // 32 * 320 ms = 10.24 s
+// The game runs at most 4 timers at once (countdown, pickups, ground
+// redraw, spectator); 14 bytes of RAM each
+#ifndef TIMER_POOL_SIZE
+#define TIMER_POOL_SIZE 6
+#endif
+#define TIMER_NONE 0xFF
+#define TIMER_NO_DEADLINE 0xFFFFFFFFUL
+
+typedef void (*TimerCallback)(uint8_t arg);
+
+void timerWheelReset(unsigned long now);
+uint8_t timerStart(unsigned long delayMs, unsigned long periodMs, TimerCallback callback, uint8_t arg);
+void timerCancel(uint8_t id);
+void timerWheelAdvance(unsigned long now);
+unsigned long timerWheelNextDeadline(unsigned long now);
+uint8_t timerWheelActiveCount();
+
+#endif
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""Convert a designed screen (PNG) into a palette + RLE asset header.
+
+Usage: rle_encode.py <image.png> <asset_name> [output.h]
+
+The image must be 8-bit RGB or RGBA, at most 255x255, with no more than 16
+distinct colors. Colors are converted to RGB565 and the pixels are run-length
+encoded in raster order in the token format described in rle.h.
+"""
+
+import struct
+import sys
+import zlib
+
+MAX_PALETTE = 16
+
+
+def read_png(path):
+    """Decode a non-interlaced 8-bit RGB/RGBA PNG into rows of (r, g, b)."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("%s is not a PNG file" % path)
+
+    pos = 8
+    idat = b""
+    width = height = color_type = None
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+            if depth != 8 or color_type not in (2, 6) or interlace != 0:
+                raise ValueError("only 8-bit non-interlaced RGB/RGBA PNGs are supported")
+        elif kind == b"IDAT":
+            idat += chunk
+        elif kind == b"IEND":
+            break
+
+    channels = 3 if color_type == 2 else 4
+    stride = width * channels
+    raw = zlib.decompress(idat)
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        filter_type = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - channels] if i >= channels else 0
+            b = prev[i]
+            c = prev[i - channels] if i >= channels else 0
+            if filter_type == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif filter_type == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif filter_type == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif filter_type == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                line[i] = (line[i] + pred) & 0xFF
+        rows.append([tuple(line[x * channels:x * channels + 3]) for x in range(width)])
+        prev = line
+    return width, height, rows
+
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def encode(width, height, rows):
+    """Return (palette, tokens) for the image."""
+    palette = []
+    pixels = []
+    for row in rows:
+        for r, g, b in row:
+            color = rgb565(r, g, b)
+            if color not in palette:
+                palette.append(color)
+                if len(palette) > MAX_PALETTE:
+                    raise ValueError("image has more than %d colors" % MAX_PALETTE)
+            pixels.append(palette.index(color))
+
+    tokens = bytearray()
+    i = 0
+    while i < len(pixels):
+        index = pixels[i]
+        run = 1
+        while i + run < len(pixels) and pixels[i + run] == index and run < 271:
+            run += 1
+        if run < 16:
+            tokens.append((index << 4) | (run - 1))
+        else:
+            tokens.append((index << 4) | 0x0F)
+            tokens.append(run - 16)
+        i += run
+    return palette, tokens
+
+
+def write_header(out, name, width, height, palette, tokens):
+    guard = "ASSET_%s_H" % name.upper()
+    out.write("// Generated by tools/rle_encode.py, do not edit.\n")
+    out.write("// %dx%d, %d colors, %d bytes of runs (%d bytes uncompressed)\n"
+              % (width, height, len(palette), len(tokens), width * height * 2))
+    out.write("#ifndef %s\n#define %s\n\n" % (guard, guard))
+    out.write("#include \"rle.h\"\n\n")
+    out.write("const uint16_t %s_palette[] PROGMEM = {\n  " % name)
+    out.write(", ".join("0x%04X" % c for c in palette))
+    out.write("\n};\n\n")
+    out.write("const uint8_t %s_data[] PROGMEM = {\n" % name)
+    for i in range(0, len(tokens), 16):
+        out.write("  " + ", ".join("0x%02X" % b for b in tokens[i:i + 16]) + ",\n")
+    out.write("};\n\n")
+    out.write("const RleAsset %s = { %d, %d, %d, %s_palette, %s_data, %d };\n\n"
+              % (name, width, height, len(palette), name, name, len(tokens)))
+    out.write("#endif\n")
+
+
+def main():
+    if len(sys.argv) not in (3, 4):
+        sys.stderr.write(__doc__)
+        return 1
+
+    width, height, rows = read_png(sys.argv[1])
+    if width > 255 or height > 255:
+        sys.stderr.write("image is larger than 255x255\n")
+        return 1
+    palette, tokens = encode(width, height, rows)
+
+    if len(sys.argv) == 4:
+        with open(sys.argv[3], "w") as out:
+            write_header(out, sys.argv[2], width, height, palette, tokens)
+    else:
+        write_header(sys.stdout, sys.argv[2], width, height, palette, tokens)
+
+    sys.stderr.write("%s: %d colors, %d bytes (%.1f%% of %d raw)\n"
+                     % (sys.argv[2], len(palette), len(tokens),
+                        100.0 * len(tokens) / (width * height * 2), width * height * 2))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,244 @@
+#!/usr/bin/env python3
+"""Decode the spectator stream and rebuild the live match state.
+
+Usage: spectator_decode.py <capture.bin | serial port> [--baud N] [--quiet]
+
+Reads the frames described in spectator.h from a capture file or, if the
+argument is a serial device, straight from the board (needs pyserial) until
+Ctrl-C. The match state is printed after every frame unless --quiet is
+given, and link statistics are printed every second and at the end: bytes
+and frames per second, keyframes vs deltas, CRC errors, frames lost on the
+link (sequence gaps) and frames the board dropped itself because its buffer
+was full.
+"""
+
+import os
+import sys
+import time
+
+SYNC = 0xA5
+KEYFRAME, DELTA, END = 0, 1, 2
+MAX_COINS = 4
+
+CHANGE_BALL1 = 0x01
+CHANGE_BALL2 = 0x02
+CHANGE_SCORE1 = 0x04
+CHANGE_SCORE2 = 0x08
+CHANGE_TIME = 0x10
+CHANGE_COINS = 0x20
+CHANGE_BALL1_LONG = 0x40
+CHANGE_BALL2_LONG = 0x80
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+class Reader:
+    def __init__(self, payload):
+        self.payload = payload
+        self.pos = 0
+
+    def byte(self):
+        value = self.payload[self.pos]
+        self.pos += 1
+        return value
+
+    def varint(self):
+        value = shift = 0
+        while True:
+            byte = self.byte()
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
+
+
+class MatchState:
+    def __init__(self):
+        self.valid = False     # False until the first keyframe
+        self.balls = [[0, 0], [0, 0]]
+        self.scores = [0, 0]
+        self.remaining_time = 0
+        self.coins = [None] * MAX_COINS
+        self.board_dropped = 0
+
+    def apply_keyframe(self, r):
+        for ball in self.balls:
+            ball[0] = r.byte()
+            ball[1] = r.byte()
+        self.scores = [r.varint(), r.varint()]
+        self.remaining_time = r.byte()
+        active = r.byte()
+        for i in range(MAX_COINS):
+            self.coins[i] = (r.byte(), r.byte()) if active & (1 << i) else None
+        self.board_dropped = r.varint()
+        self.valid = True
+
+    def apply_ball(self, r, ball, is_long):
+        if is_long:
+            dx, dy = unzigzag(r.varint()), unzigzag(r.varint())
+        else:
+            packed = r.byte()
+            dx, dy = unzigzag(packed & 0x0F), unzigzag(packed >> 4)
+        self.balls[ball][0] += dx
+        self.balls[ball][1] += dy
+
+    def apply_delta(self, r):
+        mask = r.byte()
+        if mask & CHANGE_BALL1:
+            self.apply_ball(r, 0, mask & CHANGE_BALL1_LONG)
+        if mask & CHANGE_BALL2:
+            self.apply_ball(r, 1, mask & CHANGE_BALL2_LONG)
+        if mask & CHANGE_SCORE1:
+            self.scores[0] += unzigzag(r.varint())
+        if mask & CHANGE_SCORE2:
+            self.scores[1] += unzigzag(r.varint())
+        if mask & CHANGE_TIME:
+            self.remaining_time += unzigzag(r.varint())
+        if mask & CHANGE_COINS:
+            slots = r.byte()
+            changed, active = slots & 0x0F, slots >> 4
+            for i in range(MAX_COINS):
+                if changed & (1 << i):
+                    self.coins[i] = (r.byte(), r.byte()) if active & (1 << i) else None
+
+    def __str__(self):
+        coins = " ".join("(%d,%d)" % c for c in self.coins if c is not None)
+        return ("t=%2d  P1 %3d @(%3d,%3d)  P2 %3d @(%3d,%3d)  coins: %s"
+                % (self.remaining_time, self.scores[0], self.balls[0][0], self.balls[0][1],
+                   self.scores[1], self.balls[1][0], self.balls[1][1], coins or "-"))
+
+
+class Stats:
+    def __init__(self):
+        self.start = time.time()
+        self.bytes = 0
+        self.keyframes = 0
+        self.deltas = 0
+        self.crc_errors = 0
+        self.lost = 0          # Sequence gaps on the link
+        self.skipped = 0       # Deltas ignored while waiting for a keyframe
+
+    def report(self, state, out=sys.stderr):
+        elapsed = max(time.time() - self.start, 1e-6)
+        frames = self.keyframes + self.deltas
+        out.write("%.0f B/s, %.1f frames/s, %d keyframes, %d deltas, %d CRC errors, "
+                  "%d lost on link, %d skipped, %d dropped on board\n"
+                  % (self.bytes / elapsed, frames / elapsed, self.keyframes, self.deltas,
+                     self.crc_errors, self.lost, self.skipped, state.board_dropped))
+
+
+def frames(stream, stats, live):
+    """Yield (type, seq, payload) for every frame with a valid CRC.
+
+    A capture file ends at EOF. A live port's read() comes back empty
+    whenever the board is quiet (between matches, say), so that only
+    means try again; it runs until interrupted.
+    """
+    buf = bytearray()
+    while True:
+        chunk = stream.read(64)
+        if not chunk:
+            if live:
+                continue
+            return
+        stats.bytes += len(chunk)
+        buf += chunk
+        while True:
+            start = buf.find(SYNC)
+            if start < 0:
+                buf.clear()
+                break
+            del buf[:start]
+            if len(buf) < 3 or len(buf) < 4 + buf[2]:
+                break
+            length = buf[2]
+            body = bytes(buf[1:3 + length])
+            if crc8(body) != buf[3 + length]:
+                # Not a frame after all, resync on the next sync byte
+                stats.crc_errors += 1
+                del buf[:1]
+                continue
+            del buf[:4 + length]
+            yield body[0] >> 6, body[0] & 0x3F, body[2:]
+
+
+def open_stream(path, baud):
+    """Return (stream, live): a capture file, or the board's serial port."""
+    if os.path.exists(path) and not path.startswith("/dev/") and not path.upper().startswith("COM"):
+        return open(path, "rb"), False
+    import serial  # pyserial, only needed for live capture
+    return serial.Serial(path, baud, timeout=0.1), True
+
+
+def main():
+    args = [a for a in sys.argv[1:] if not a.startswith("--")]
+    quiet = "--quiet" in sys.argv
+    baud = 9600
+    if "--baud" in sys.argv:
+        baud = int(sys.argv[sys.argv.index("--baud") + 1])
+        args.remove(str(baud))
+    if len(args) != 1:
+        sys.stderr.write(__doc__)
+        return 1
+
+    state = MatchState()
+    stats = Stats()
+    expected_seq = None
+    last_report = time.time()
+
+    stream, live = open_stream(args[0], baud)
+    try:
+        for kind, seq, payload in frames(stream, stats, live):
+            if expected_seq is not None and seq != expected_seq:
+                stats.lost += (seq - expected_seq) & 0x3F
+                if kind == DELTA:
+                    state.valid = False
+            expected_seq = (seq + 1) & 0x3F
+
+            try:
+                if kind == KEYFRAME:
+                    state.apply_keyframe(Reader(payload))
+                    stats.keyframes += 1
+                elif kind == DELTA:
+                    if not state.valid:
+                        stats.skipped += 1
+                        continue
+                    state.apply_delta(Reader(payload))
+                    stats.deltas += 1
+            except IndexError:
+                # A false frame that passed the CRC ran past its payload.
+                # Count it with the CRC errors and wait for a keyframe.
+                stats.crc_errors += 1
+                state.valid = False
+                continue
+
+            if kind == END:
+                print("match over: P1 %d, P2 %d" % tuple(state.scores))
+                state.valid = False
+                continue
+
+            if not quiet:
+                print(state)
+            if time.time() - last_report >= 1.0:
+                stats.report(state)
+                last_report = time.time()
+    except KeyboardInterrupt:
+        pass   # The way out of a live session
+
+    stats.report(state)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
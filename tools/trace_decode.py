@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""Convert the binary trace stream into Chrome trace format (JSON).
+
+Usage: trace_decode.py <capture.bin | serial port> [output.json] [--baud N]
+
+Reads the records described in trace.h from a capture file or, if the
+argument is a serial device, straight from the board (needs pyserial) until
+Ctrl-C. The JSON goes to output.json, or to stdout if none is given; load it
+in chrome://tracing or ui.perfetto.dev. Each "TRC1" start marker (a board
+reset) begins a new process track. Counts are printed to stderr at the end.
+"""
+
+import json
+import os
+import sys
+
+MAGIC = b"TRC1"
+BEGIN, END, DRAW, DROPPED = 0, 1, 2, 3
+
+# TraceName order in trace.h
+NAMES = ["frame", "input", "timers", "move", "collide", "scoreboard", "drawBalls",
+         "clear", "drawRectangle", "fillRectangle", "drawCircle", "fillCircle",
+         "drawLine", "drawText"]
+
+# Modelled cost of the bit-banged SPI: bit time, and bits per window setup
+SPI_BIT_NS = 500
+WINDOW_BITS = 224
+
+
+class Source:
+    """Bytes from a capture file or a live port, with one byte of push-back."""
+
+    def __init__(self, stream, live):
+        self.stream = stream
+        self.live = live
+        self.buf = b""
+        self.pos = 0
+        self.bytes = 0
+
+    def byte(self):
+        while self.pos == len(self.buf):
+            chunk = self.stream.read(64)
+            if not chunk:
+                if self.live:
+                    continue   # Board quiet, try again
+                raise EOFError
+            self.buf, self.pos = chunk, 0
+            self.bytes += len(chunk)
+        value = self.buf[self.pos]
+        self.pos += 1
+        return value
+
+    def unread(self):
+        self.pos -= 1
+
+    def varint(self):
+        value = shift = 0
+        while True:
+            byte = self.byte()
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
+
+
+def sync(source):
+    """Skip to just after the next start marker."""
+    matched = 0
+    while matched < len(MAGIC):
+        byte = source.byte()
+        if byte == MAGIC[matched]:
+            matched += 1
+        else:
+            matched = 1 if byte == MAGIC[0] else 0
+
+
+def events(source, counts):
+    """Yield Chrome trace events, one process per start marker."""
+    pid = 0
+    while True:
+        sync(source)
+        pid += 1
+        ts = 0
+        while True:
+            header = source.byte()
+            kind, name = header >> 4, header & 0x0F
+            if kind > DROPPED or (kind != DROPPED and name >= len(NAMES)):
+                # Not a record: the board restarted, or a byte was lost
+                counts["resyncs"] += 1
+                source.unread()
+                break
+            delta = source.varint()
+            ts += delta - (1 << 32) if delta >= 1 << 31 else delta
+            counts["records"] += 1
+            if kind == DRAW:
+                duration = source.varint()
+                pixels = source.varint()
+                windows = source.varint()
+                spi_us = (windows * WINDOW_BITS + pixels * 16) * SPI_BIT_NS // 1000
+                yield {"name": NAMES[name], "ph": "X", "ts": ts, "dur": duration,
+                       "pid": pid, "tid": 1, "args": {"pixels": pixels, "spi_us": spi_us}}
+            elif kind == DROPPED:
+                dropped = source.varint()
+                counts["dropped"] = dropped
+                yield {"name": "dropped", "ph": "C", "ts": ts, "pid": pid,
+                       "args": {"events": dropped}}
+            else:
+                yield {"name": NAMES[name], "ph": "B" if kind == BEGIN else "E",
+                       "ts": ts, "pid": pid, "tid": 1}
+
+
+def open_stream(path, baud):
+    """Return (stream, live): a capture file, or the board's serial port."""
+    if os.path.exists(path) and not path.startswith("/dev/") and not path.upper().startswith("COM"):
+        return open(path, "rb"), False
+    import serial  # pyserial, only needed for live capture
+    return serial.Serial(path, baud, timeout=0.1), True
+
+
+def main():
+    args = [a for a in sys.argv[1:] if not a.startswith("--")]
+    baud = 115200
+    if "--baud" in sys.argv:
+        baud = int(sys.argv[sys.argv.index("--baud") + 1])
+        args.remove(str(baud))
+    if len(args) not in (1, 2):
+        sys.stderr.write(__doc__)
+        return 1
+
+    stream, live = open_stream(args[0], baud)
+    out = open(args[1], "w") if len(args) == 2 else sys.stdout
+    source = Source(stream, live)
+    counts = {"records": 0, "resyncs": 0, "dropped": 0}
+
+    # Written as it goes; the viewers also accept the array left open if the
+    # process is killed
+    out.write("[\n")
+    first = True
+    try:
+        for event in events(source, counts):
+            out.write(("" if first else ",\n") + json.dumps(event, separators=(",", ":")))
+            first = False
+    except EOFError:
+        pass   # A record cut off at the end of the capture is left out
+    except KeyboardInterrupt:
+        pass   # The way out of a live session
+    out.write("\n]\n")
+    out.flush()
+
+    sys.stderr.write("%d bytes, %d records, %d resyncs, %d events dropped on board\n"
+                     % (source.bytes, counts["records"], counts["resyncs"], counts["dropped"]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,175 @@
+#include "trace.h"
+
+// Record kinds, the high nibble of a record header
+enum {
+  KIND_BEGIN,
+  KIND_END,
+  KIND_DRAW,
+  KIND_DROPPED
+};
+
+struct TraceEvent {
+  uint8_t name;
+  uint8_t kind;
+  uint16_t pixels;          // Draw calls only
+  uint16_t windows;         // Draw calls only
+  unsigned long timestamp;  // us since traceStart()
+  unsigned long duration;   // Measured time of a draw call
+};
+
+TraceStats traceStats;
+
+static TraceEvent traceBuffer[TRACE_BUFFER_EVENTS];
+static uint8_t traceHead = 0;       // Next slot to write
+static uint8_t traceCount = 0;      // Events waiting to be streamed
+static uint8_t traceDepth = 0;      // Open 'B' phases, recorded or not
+static uint8_t traceOpenMask = 0;   // Bit per depth: was that 'B' recorded?
+static uint8_t traceOpen = 0;       // Recorded 'B' phases still waiting for their 'E'
+static unsigned long traceEpoch = 0;
+static unsigned long lastTimestamp = 0;   // Of the last record serialized
+static unsigned long reportedDrops = 0;
+
+// Record currently being streamed out
+static uint8_t traceRecord[TRACE_RECORD_SIZE];
+static uint8_t traceRecordLength = 0;
+static uint8_t traceRecordPos = 0;
+
+// Start the trace stream. Resets the buffer and sends the start marker.
+void traceStart() {
+  memset(&traceStats, 0, sizeof(traceStats));
+  traceHead = 0;
+  traceCount = 0;
+  traceDepth = 0;
+  traceOpenMask = 0;
+  traceOpen = 0;
+  reportedDrops = 0;
+  traceEpoch = micros();
+  lastTimestamp = 0;
+  strcpy_P((char*)traceRecord, PSTR("TRC1"));
+  traceRecordLength = 4;
+  traceRecordPos = 0;
+}
+
+static TraceEvent* traceAppend() {
+  TraceEvent* event = &traceBuffer[traceHead];
+  traceHead = (traceHead + 1) % TRACE_BUFFER_EVENTS;
+  traceCount++;
+  traceStats.recorded++;
+  return event;
+}
+
+// Record the begin or end of a phase. A 'B' is only recorded if there is
+// room left for its matching 'E', so the stream always stays balanced.
+// Each 'E' also tops up the serial buffer, so the link keeps draining
+// during a frame; the time that takes counts towards the enclosing phase.
+void tracePhase(uint8_t name, char phase) {
+  unsigned long now = micros() - traceEpoch;
+
+  if (phase == 'B') {
+    uint8_t bit = 1 << traceDepth;
+    traceDepth++;
+    if (TRACE_BUFFER_EVENTS - traceCount < traceOpen + 2) {
+      traceOpenMask &= ~bit;
+      traceStats.dropped++;
+      return;
+    }
+    traceOpenMask |= bit;
+    traceOpen++;
+  } else {
+    if (traceDepth == 0) {
+      return;
+    }
+    traceDepth--;
+    uint8_t bit = 1 << traceDepth;
+    if (!(traceOpenMask & bit)) {
+      return;
+    }
+    traceOpenMask &= ~bit;
+    traceOpen--;
+  }
+
+  TraceEvent* event = traceAppend();
+  event->name = name;
+  event->kind = phase == 'B' ? KIND_BEGIN : KIND_END;
+  event->timestamp = now;
+  if (phase == 'E') {
+    traceFlush();
+  }
+}
+
+// Record a completed draw call
+void traceDraw(uint8_t name, unsigned long startTime, unsigned long pixels, unsigned long windows) {
+  unsigned long now = micros();
+  if (TRACE_BUFFER_EVENTS - traceCount < traceOpen + 1) {
+    traceStats.dropped++;
+    return;
+  }
+
+  TraceEvent* event = traceAppend();
+  event->name = name;
+  event->kind = KIND_DRAW;
+  event->timestamp = startTime - traceEpoch;
+  event->duration = now - startTime;
+  event->pixels = pixels > 0xFFFF ? 0xFFFF : pixels;
+  event->windows = windows > 0xFFFF ? 0xFFFF : windows;
+}
+
+static void putVarint(unsigned long value) {
+  while (value >= 0x80) {
+    traceRecord[traceRecordLength++] = (value & 0x7F) | 0x80;
+    value >>= 7;
+  }
+  traceRecord[traceRecordLength++] = value;
+}
+
+// Start a record in traceRecord: header and time since the last record
+static void startRecord(uint8_t kind, uint8_t name, unsigned long timestamp) {
+  traceRecord[0] = kind << 4 | name;
+  traceRecordLength = 1;
+  traceRecordPos = 0;
+  putVarint(timestamp - lastTimestamp);
+  lastTimestamp = timestamp;
+}
+
+// Serialize the oldest buffered event into traceRecord
+static void traceSerializeNext() {
+  uint8_t tail = (traceHead + TRACE_BUFFER_EVENTS - traceCount) % TRACE_BUFFER_EVENTS;
+  TraceEvent* event = &traceBuffer[tail];
+  traceCount--;
+
+  startRecord(event->kind, event->name, event->timestamp);
+  if (event->kind == KIND_DRAW) {
+    putVarint(event->duration);
+    putVarint(event->pixels);
+    putVarint(event->windows);
+  }
+}
+
+// Stream buffered events without ever blocking on the serial port: only as
+// many bytes as fit in the transmit buffer are written, the rest waits for
+// the next call.
+void traceFlush() {
+  while (true) {
+    if (traceRecordPos == traceRecordLength) {
+      if (traceCount > 0) {
+        traceSerializeNext();
+      } else if (traceStats.dropped != reportedDrops) {
+        // Report drops as a counter track
+        reportedDrops = traceStats.dropped;
+        startRecord(KIND_DROPPED, 0, micros() - traceEpoch);
+        putVarint(reportedDrops);
+      } else {
+        return;
+      }
+    }
+
+    int room = Serial.availableForWrite();
+    if (room <= 0) {
+      return;
+    }
+    uint8_t length = min((int)(traceRecordLength - traceRecordPos), room);
+    Serial.write(traceRecord + traceRecordPos, length);
+    traceRecordPos += length;
+    traceStats.bytesWritten += length;
+  }
+}
@@ -0,0 +1,165 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "Arduino.h"
+#include "batched_tft.h"
+
+// Timeline tracing of the game loop, streamed over Serial as compact binary
+// records. tools/trace_decode.py turns a capture into Chrome trace format
+// (JSON) for chrome://tracing or ui.perfetto.dev. A capture can be cut off
+// at any point of a long run.
+//
+// Stream:  "TRC1" at traceStart(), then one record per event:
+//            header      kind << 4 | name, kind 0 begin, 1 end, 2 draw call,
+//                        3 drop count
+//            varint      us since the previous record, modulo 2^32
+//          then for a draw call: varint duration, pixels, address windows
+//               for a drop count: varint events dropped so far
+// The decoder models a draw call's SPI time from its pixels and windows.
+//
+// Sampling rate: TRACE_BAUD carries about 11.5 KB/s. A frame that moves the
+// balls is 14 phase records of 2-3 bytes and a few draw calls of about 8
+// bytes, 60-80 bytes in all, so the link keeps up with some 150 such
+// frames a second; the bit-banged circles alone keep the game well below
+// that, and every frame goes out. A frame where nothing moves is about 30
+// bytes in a fraction of a millisecond, faster than the link: those are
+// sampled, with the events that find the ring full dropped and counted in
+// the stream. The serial buffer is topped up at every phase end, not only
+// between frames.
+//
+// Build with TRACE_ENABLED 1 to turn it on; otherwise all hooks compile away.
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 0
+#endif
+
+#define TRACE_BAUD 115200
+
+// RAM used while tracing: 14 bytes per buffered event plus the record being
+// streamed. Events are dropped when the ring buffer is full; a bigger one
+// only helps on boards with RAM to spare.
+#ifndef TRACE_BUFFER_EVENTS
+#define TRACE_BUFFER_EVENTS 16
+#endif
+#define TRACE_RECORD_SIZE 21     // Header and four 5-byte varints
+#if TRACE_BUFFER_EVENTS > 255
+#error "TRACE_BUFFER_EVENTS must fit the 8-bit ring indices"
+#endif
+
+enum TraceName {
+  TRACE_FRAME,
+  TRACE_INPUT,
+  TRACE_TIMERS,
+  TRACE_MOVE,
+  TRACE_COLLIDE,
+  TRACE_SCOREBOARD,
+  TRACE_DRAW_BALLS,
+  TRACE_CLEAR,
+  TRACE_DRAW_RECTANGLE,
+  TRACE_FILL_RECTANGLE,
+  TRACE_DRAW_CIRCLE,
+  TRACE_FILL_CIRCLE,
+  TRACE_DRAW_LINE,
+  TRACE_DRAW_TEXT,
+  TRACE_NAME_COUNT
+};
+#if TRACE_NAME_COUNT > 16
+#error "Trace names must fit the record header's low nibble"
+#endif
+
+struct TraceStats {
+  unsigned long recorded;
+  unsigned long dropped;
+  unsigned long bytesWritten;
+};
+
+extern TraceStats traceStats;
+
+void traceStart();
+void tracePhase(uint8_t name, char phase);
+void traceDraw(uint8_t name, unsigned long startTime, unsigned long pixels, unsigned long windows);
+void traceFlush();
+
+#if TRACE_ENABLED
+#define TRACE_BEGIN(name) tracePhase(name, 'B')
+#define TRACE_END(name) tracePhase(name, 'E')
+#define TRACE_FLUSH() traceFlush()
+
+// Drop-in replacement for the display object that records every draw call
+// with its pixel count and address windows
+class TracedTFT : public BatchedTFT {
+ public:
+  TracedTFT(int8_t rst, int8_t rs, int8_t cs, int8_t sdi, int8_t clk, int8_t led)
+    : BatchedTFT(rst, rs, cs, sdi, clk, led), fontWidth(6), fontHeight(8) {}
+  TracedTFT(int8_t rst, int8_t rs, int8_t cs, int8_t led)
+    : BatchedTFT(rst, rs, cs, led), fontWidth(6), fontHeight(8) {}
+
+  void clear() {
+    unsigned long startTime = micros();
+    BatchedTFT::clear();
+    traceDraw(TRACE_CLEAR, startTime, (unsigned long)maxX() * maxY(), 1);
+  }
+
+  void drawRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color) {
+    unsigned long startTime = micros();
+    BatchedTFT::drawRectangle(x1, y1, x2, y2, color);
+    traceDraw(TRACE_DRAW_RECTANGLE, startTime, 2UL * (span(x1, x2) + span(y1, y2)), 4);
+  }
+
+  void fillRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color) {
+    unsigned long startTime = micros();
+    BatchedTFT::fillRectangle(x1, y1, x2, y2, color);
+    traceDraw(TRACE_FILL_RECTANGLE, startTime, (unsigned long)span(x1, x2) * span(y1, y2), 1);
+  }
+
+  // Outline circles are plotted pixel by pixel, one window each
+  void drawCircle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t color) {
+    unsigned long startTime = micros();
+    BatchedTFT::drawCircle(x0, y0, radius, color);
+    unsigned long pixels = 44UL * radius / 7;
+    traceDraw(TRACE_DRAW_CIRCLE, startTime, pixels, pixels);
+  }
+
+  // Filled circles are drawn as 2r + 1 horizontal spans
+  void fillCircle(uint8_t x0, uint8_t y0, uint8_t radius, uint16_t color) {
+    unsigned long startTime = micros();
+    BatchedTFT::fillCircle(x0, y0, radius, color);
+    traceDraw(TRACE_FILL_CIRCLE, startTime, 22UL * radius * radius / 7, 2UL * radius + 1);
+  }
+
+  void drawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color) {
+    unsigned long startTime = micros();
+    BatchedTFT::drawLine(x1, y1, x2, y2, color);
+    unsigned long pixels = max(span(x1, x2), span(y1, y2));
+    traceDraw(TRACE_DRAW_LINE, startTime, pixels, (x1 == x2 || y1 == y2) ? 1 : pixels);
+  }
+
+  void setFont(uint8_t* font, bool monoSp = false) {
+    fontWidth = pgm_read_byte(&font[0]);
+    fontHeight = pgm_read_byte(&font[1]);
+    BatchedTFT::setFont(font, monoSp);
+  }
+
+  // Glyph pixels are written one at a time
+  uint16_t drawText(uint16_t x, uint16_t y, const char* s, uint16_t color = COLOR_WHITE) {
+    unsigned long startTime = micros();
+    uint16_t result = BatchedTFT::drawText(x, y, s, color);
+    unsigned long pixels = (unsigned long)strlen(s) * fontWidth * fontHeight;
+    traceDraw(TRACE_DRAW_TEXT, startTime, pixels, pixels);
+    return result;
+  }
+
+ private:
+  static uint16_t span(uint16_t a, uint16_t b) {
+    return (a > b ? a - b : b - a) + 1;
+  }
+
+  uint8_t fontWidth;
+  uint8_t fontHeight;
+};
+#else
+#define TRACE_BEGIN(name)
+#define TRACE_END(name)
+#define TRACE_FLUSH()
+#endif
+
+#endif